@@ -0,0 +1,359 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ga.h"
+#include "ga.inc"
+#include "sudoku.h"
+#include "batch.h"
+
+/**
+ * The pending puzzles of a worker: a range of puzzle indices. The owner takes puzzles from the front
+ * while idle workers steal the back half.
+ */
+typedef struct {
+    pthread_mutex_t mutex;
+    unsigned int begin;
+    unsigned int end;
+} _Deque;
+
+typedef struct _Batch _Batch;
+
+typedef struct {
+    _Batch *batch;
+    unsigned int index;
+    pthread_t thread;
+    Solver *solver;
+} _Worker;
+
+struct _Batch {
+    const unsigned int *puzzles;
+    const BatchSettings *settings;
+    BatchResult *results;
+    FILE *output;
+    unsigned int workers;
+    _Deque *deques;
+    _Worker *threads;
+    pthread_mutex_t output_mutex;
+    atomic_bool failed;
+    atomic_uint pending;
+};
+
+/**
+ * Gets the time elapsed since an arbitrary origin.
+ * @return the time in seconds.
+ */
+static double _now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+/**
+ * Reads puzzles, one per line: 81 cells given row by row as digits, 0 or '.' for an empty cell. Blank lines
+ * and lines starting with '#' are skipped, and so are the lines holding another number of cells.
+ * @param stream the stream.
+ * @param count the number of puzzles read.
+ * @return the puzzles (81 cells each, to free) or NULL.
+ */
+unsigned int *sudoku_batch_read(FILE *stream, unsigned int *count) {
+    unsigned int capacity = 64;
+    unsigned int *puzzles = malloc(sizeof(unsigned int) * 81 * capacity);
+    char *line = NULL;
+    size_t length = 0;
+    unsigned int number = 0;
+    *count = 0;
+    if (!puzzles) {
+        return NULL;
+    }
+    while (getline(&line, &length, stream) != -1) {
+        unsigned int cells[81];
+        unsigned int size = 0;
+        bool valid = true;
+        number++;
+        if (line[0] == '#' || line[strspn(line, " \t\r\n")] == '\0') {
+            continue;
+        }
+        for (const char *c = line; *c && *c != '\n' && *c != '\r' && valid; c++) {
+            if ((*c >= '0' && *c <= '9') || *c == '.') {
+                if (size < 81) {
+                    cells[size] = *c == '.' ? 0 : (unsigned int)(*c - '0');
+                }
+                size++;
+            } else if (*c != ' ' && *c != '\t') {
+                valid = false;
+            }
+        }
+        if (!valid || size != 81) {
+            fprintf(stderr, "Skipping line %u: not a sudoku of 81 cells\n", number);
+            continue;
+        }
+        if (*count == capacity) {
+            unsigned int *grown = realloc(puzzles, sizeof(unsigned int) * 81 * capacity * 2);
+            if (!grown) {
+                free(line);
+                free(puzzles);
+                return NULL;
+            }
+            puzzles = grown;
+            capacity *= 2;
+        }
+        memcpy(puzzles + 81 * *count, cells, sizeof(cells));
+        (*count)++;
+    }
+    free(line);
+    return puzzles;
+}
+
+/**
+ * Takes the next puzzle of a worker, stealing the back half of the pending puzzles of another worker when
+ * its own are done. A steal refills the deque of the thief, so a scan may miss puzzles in transit: the
+ * worker scans again until no puzzle is pending.
+ * @param worker the worker.
+ * @param puzzle the puzzle taken.
+ * @return whether a puzzle was taken.
+ */
+static bool _batch_take(_Worker *worker, unsigned int *puzzle) {
+    _Batch *batch = worker->batch;
+    _Deque *own = &batch->deques[worker->index];
+    pthread_mutex_lock(&own->mutex);
+    if (own->begin < own->end) {
+        *puzzle = own->begin++;
+        pthread_mutex_unlock(&own->mutex);
+        atomic_fetch_sub(&batch->pending, 1);
+        return true;
+    }
+    pthread_mutex_unlock(&own->mutex);
+    for (unsigned int i = 1; atomic_load(&batch->pending); i = i % batch->workers + 1) {
+        if (i == batch->workers) {
+            /* every victim was empty: their puzzles are being stolen, let the thieves store them */
+            sched_yield();
+            continue;
+        }
+        _Deque *victim = &batch->deques[(worker->index + i) % batch->workers];
+        unsigned int begin;
+        unsigned int end;
+        pthread_mutex_lock(&victim->mutex);
+        begin = victim->begin + (victim->end - victim->begin) / 2;
+        end = victim->end;
+        victim->end = begin;
+        pthread_mutex_unlock(&victim->mutex);
+        if (begin < end) {
+            pthread_mutex_lock(&own->mutex);
+            *puzzle = begin;
+            own->begin = begin + 1;
+            own->end = end;
+            pthread_mutex_unlock(&own->mutex);
+            atomic_fetch_sub(&batch->pending, 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Solves a puzzle: evolves a population until the sudoku is solved, the generations or the time are exhausted,
+ * or the best score stagnates.
+ * The random stream of the solver is the index of the puzzle, so the outcome does not depend on the
+ * worker solving it.
+ * @param worker the worker.
+ * @param puzzle the index of the puzzle.
+ * @return whether the population could be created.
+ */
+static bool _batch_solve(_Worker *worker, unsigned int puzzle) {
+    _Batch *batch = worker->batch;
+    const BatchSettings *settings = batch->settings;
+    BatchResult *result = &batch->results[puzzle];
+    double start = _now();
+    Sudoku *sudoku = sudoku_create(batch->puzzles + 81 * (size_t)puzzle);
+    GeneticGenerator *generator = sudoku ? sudoku_generator(sudoku) : NULL;
+    Population *population = NULL;
+    StopCriteria criteria = {settings->generations, 0, settings->stagnation, settings->time, 0};
+    ga_solver_reset(worker->solver, settings->seed, puzzle);
+    if (generator) {
+        population = ga_population_create(worker->solver, generator, settings->individuals);
+    }
+    if (!population) {
+        if (generator) {
+            genetic_generator_destroy(generator);
+        }
+        sudoku_destroy(sudoku);
+        return false;
+    }
+    result->reason = GA_STOP_GENERATIONS;
+    if (settings->generations) {
+        result->reason = ga_run(worker->solver, population, &criteria, settings->cross_over, settings->mutation,
+                                sudoku_fitness, sudoku);
+    }
+    ga_population_destroy(population);
+    genetic_generator_destroy(generator);
+    sudoku_destroy(sudoku);
+    result->score = get_best_score(worker->solver);
+    result->generations = ga_solver_get_generation(worker->solver) - 1;
+    result->elapsed = _now() - start;
+    result->local_search = ga_solver_get_local_search_time(worker->solver);
+    if (batch->output) {
+        pthread_mutex_lock(&batch->output_mutex);
+        fprintf(batch->output, "puzzle %u: score %u, generations %u, elapsed %.3f ms, local search %.3f ms, stop %s\n",
+                puzzle, result->score, result->generations, result->elapsed * 1e3, result->local_search * 1e3,
+                ga_stop_reason_to_string(result->reason));
+        pthread_mutex_unlock(&batch->output_mutex);
+    }
+    return true;
+}
+
+/**
+ * The loop of a worker: solves puzzles until none is left.
+ * @param arg the worker.
+ * @return NULL.
+ */
+static void *_batch_worker(void *arg) {
+    _Worker *worker = arg;
+    unsigned int puzzle;
+    while (!worker->batch->failed && _batch_take(worker, &puzzle)) {
+        if (!_batch_solve(worker, puzzle)) {
+            worker->batch->failed = true;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Solves a batch of puzzles with a pool of workers, the calling thread included. Each worker starts with
+ * a contiguous share of the puzzles and steals from the others once done, since the difficulty of the
+ * puzzles varies wildly.
+ * @param puzzles the puzzles (81 cells each).
+ * @param count the number of puzzles.
+ * @param settings the settings of the batch.
+ * @param results the outcome of each puzzle.
+ * @param output the stream receiving a line per solved puzzle (NULL for none).
+ * @return whether every puzzle could be solved.
+ */
+bool sudoku_batch_solve(const unsigned int *puzzles, unsigned int count, const BatchSettings *settings,
+                        BatchResult *results, FILE *output) {
+    _Batch batch = {puzzles, settings, results, output, settings->workers, NULL, NULL,
+                    PTHREAD_MUTEX_INITIALIZER, false, count};
+    unsigned int started = 0;
+    if (!batch.workers) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        batch.workers = online > 0 ? (unsigned int)online : 1;
+    }
+    batch.deques = malloc(sizeof(_Deque) * batch.workers);
+    batch.threads = calloc(batch.workers, sizeof(_Worker));
+    if (!batch.deques || !batch.threads) {
+        batch.failed = true;
+    } else {
+        for (unsigned int i = 0; i < batch.workers; i++) {
+            _Worker *worker = &batch.threads[i];
+            pthread_mutex_init(&batch.deques[i].mutex, NULL);
+            batch.deques[i].begin = (unsigned int)((unsigned long long)count * i / batch.workers);
+            batch.deques[i].end = (unsigned int)((unsigned long long)count * (i + 1) / batch.workers);
+            worker->batch = &batch;
+            worker->index = i;
+            worker->solver = ga_solver_create(settings->seed);
+            if (!worker->solver) {
+                batch.failed = true;
+                continue;
+            }
+            ga_solver_set_verbose(worker->solver, false);
+            ga_solver_set_delta_evaluate(worker->solver, sudoku_fitness_delta, SUDOKU_DELTA_LIMIT);
+            ga_solver_set_batch_evaluate(worker->solver, sudoku_fitness_batch);
+            ga_solver_set_cross_over(worker->solver, settings->cross_over_operator);
+            ga_solver_set_cache(worker->solver, settings->cache);
+            if (settings->local_search > 0) {
+                ga_solver_set_local_search(worker->solver, sudoku_local_search, settings->local_search,
+                                           GA_LOCAL_SEARCH_BEST);
+            }
+        }
+        /* the deques are all set before any worker may steal */
+        for (started = 1; started < batch.workers && !batch.failed; started++) {
+            if (pthread_create(&batch.threads[started].thread, NULL, _batch_worker, &batch.threads[started])) {
+                break;
+            }
+        }
+        if (!batch.failed) {
+            _batch_worker(&batch.threads[0]);
+        }
+        for (unsigned int i = 1; i < started; i++) {
+            pthread_join(batch.threads[i].thread, NULL);
+        }
+        for (unsigned int i = 0; i < batch.workers; i++) {
+            pthread_mutex_destroy(&batch.deques[i].mutex);
+            if (batch.threads[i].solver) {
+                ga_solver_destroy(batch.threads[i].solver);
+            }
+        }
+    }
+    pthread_mutex_destroy(&batch.output_mutex);
+    free(batch.threads);
+    free(batch.deques);
+    return !batch.failed;
+}
+
+/**
+ * Compares two durations for qsort.
+ */
+static int _compare_durations(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Gets the durations of the puzzles of a batch, sorted in increasing order.
+ * @param results the outcome of each puzzle.
+ * @param count the number of puzzles.
+ * @return the durations in seconds (to free) or NULL.
+ */
+double *sudoku_batch_durations(const BatchResult *results, unsigned int count) {
+    double *durations = malloc(sizeof(double) * (count ? count : 1));
+    if (!durations) {
+        return NULL;
+    }
+    for (unsigned int i = 0; i < count; i++) {
+        durations[i] = results[i].elapsed;
+    }
+    qsort(durations, count, sizeof(double), _compare_durations);
+    return durations;
+}
+
+/**
+ * Gets a percentile of sorted durations, by nearest rank.
+ * @param durations the durations, sorted in increasing order.
+ * @param count the number of durations.
+ * @param permille the percentile in thousandths, at most 1000 (500 for the median).
+ * @return the duration (0 without durations).
+ */
+double sudoku_batch_percentile(const double *durations, unsigned int count, unsigned int permille) {
+    unsigned long long rank = ((unsigned long long)count * permille + 999) / 1000;
+    return count ? durations[rank ? rank - 1 : 0] : 0.0;
+}
+
+/**
+ * Writes the summary of a batch: the number of solved puzzles, the throughput and the latency percentiles.
+ * @param results the outcome of each puzzle.
+ * @param count the number of puzzles.
+ * @param elapsed the duration of the batch in seconds.
+ * @param output the stream.
+ */
+void sudoku_batch_summary(const BatchResult *results, unsigned int count, double elapsed, FILE *output) {
+    static const unsigned int percentiles[3] = {500, 900, 990};
+    double *durations = sudoku_batch_durations(results, count);
+    unsigned int solved = 0;
+    if (!durations) {
+        return;
+    }
+    for (unsigned int i = 0; i < count; i++) {
+        solved += !results[i].score;
+    }
+    fprintf(output, "solved %u/%u puzzles in %.3f s, %.1f puzzles/s", solved, count, elapsed,
+            elapsed > 0 ? count / elapsed : 0.0);
+    for (unsigned int i = 0; i < 3; i++) {
+        fprintf(output, ", p%u %.3f ms", percentiles[i] / 10,
+                sudoku_batch_percentile(durations, count, percentiles[i]) * 1e3);
+    }
+    fprintf(output, "\n");
+    free(durations);
+}
@@ -0,0 +1,47 @@
+//
+// Created by Brokeos on 20/12/2019.
+//
+
+#ifndef GENETIC_ALGORITHM_BATCH_H
+#define GENETIC_ALGORITHM_BATCH_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include "ga.h"
+
+/**
+ * The settings of a batch of sudokus: every puzzle is solved with the same parameters.
+ */
+typedef struct {
+    float cross_over;
+    float mutation;
+    unsigned int individuals;
+    unsigned int generations;
+    unsigned int workers;
+    unsigned long long seed;
+    float local_search;
+    unsigned int stagnation;
+    double time;
+    CrossOverFunction cross_over_operator;
+    unsigned int cache;
+} BatchSettings;
+
+/**
+ * The outcome of a puzzle of a batch.
+ */
+typedef struct {
+    unsigned int score;
+    unsigned int generations;
+    double elapsed;
+    double local_search;
+    StopReason reason;
+} BatchResult;
+
+extern unsigned int *sudoku_batch_read(FILE *stream, unsigned int *count);
+extern bool sudoku_batch_solve(const unsigned int *puzzles, unsigned int count, const BatchSettings *settings,
+                               BatchResult *results, FILE *output);
+extern double *sudoku_batch_durations(const BatchResult *results, unsigned int count);
+extern double sudoku_batch_percentile(const double *durations, unsigned int count, unsigned int permille);
+extern void sudoku_batch_summary(const BatchResult *results, unsigned int count, double elapsed, FILE *output);
+
+#endif //GENETIC_ALGORITHM_BATCH_H
@@ -0,0 +1,337 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ga.h"
+#include "ga.inc"
+#include "sudoku.h"
+#include "batch.h"
+
+/**
+ * The minimum duration of the measured run of a micro-benchmark, in seconds.
+ */
+#define BENCH_MIN_TIME 0.2
+
+/**
+ * The maximum number of bytes of the two genome matrices of a benchmarked population.
+ */
+#define BENCH_MAX_BYTES (1ULL << 28)
+
+/**
+ * The number of seeds the puzzles of the macro-benchmark are solved with.
+ */
+#define BENCH_SEEDS 20
+
+/**
+ * The puzzle of sudoku.yaml, solved by the macro-benchmark when no puzzle file is given.
+ */
+static const char BENCH_PUZZLE[] =
+    "..6.......8..542...4..9..7...79..3......8.4..6.....1..2.3.67981...5...4.478319562";
+
+/**
+ * Runs a number of iterations of a micro-benchmark.
+ * @param state the state of the benchmark.
+ * @param iterations the number of iterations.
+ * @return a value depending on every iteration, so that none is optimised away.
+ */
+typedef unsigned long long (*BenchFunction)(void *state, unsigned long long iterations);
+
+static volatile unsigned long long sink;
+
+/**
+ * Gets the time elapsed since an arbitrary origin.
+ * @return the time in seconds.
+ */
+static double _now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+/**
+ * Measures a micro-benchmark, doubling the number of iterations until a run lasts BENCH_MIN_TIME, and writes
+ * its result as a JSON line.
+ * @param name the name of the benchmark.
+ * @param population the number of individuals involved (0 if irrelevant).
+ * @param length the number of chromosomes of a genome (0 if irrelevant).
+ * @param function the benchmark.
+ * @param state the state of the benchmark.
+ */
+static void _bench(const char *name, unsigned int population, unsigned int length, BenchFunction function,
+                   void *state) {
+    unsigned long long iterations = 1;
+    double elapsed;
+    for (;;) {
+        double start = _now();
+        sink += function(state, iterations);
+        elapsed = _now() - start;
+        if (elapsed >= BENCH_MIN_TIME) {
+            break;
+        }
+        iterations *= 2;
+    }
+    printf("{\"suite\": \"micro\", \"benchmark\": \"%s\", \"population\": %u, \"length\": %u, "
+           "\"iterations\": %llu, \"seconds\": %.6f, \"ns_per_op\": %.3f}\n",
+           name, population, length, iterations, elapsed, elapsed * 1e9 / (double)iterations);
+    fflush(stdout);
+}
+
+/**
+ * The state of the fitness benchmarks: a genome and its problem.
+ */
+typedef struct {
+    EvaluateFunction evaluate;
+    unsigned char *genome;
+    const void *problem;
+    unsigned int length;
+} _Fitness;
+
+static unsigned long long _bench_fitness(void *state, unsigned long long iterations) {
+    _Fitness *fitness = state;
+    unsigned long long sum = 0;
+    for (unsigned long long i = 0; i < iterations; i++) {
+        /* a changing genome, so that nothing is hoisted out of the loop */
+        fitness->genome[i % fitness->length] ^= 1;
+        sum += fitness->evaluate(fitness->genome, fitness->problem);
+    }
+    return sum;
+}
+
+/**
+ * The state of the fortune wheel benchmark.
+ */
+typedef struct {
+    Fortune_Rank *ranks;
+    unsigned int size;
+    Random random;
+} _Wheel;
+
+static unsigned long long _bench_wheel(void *state, unsigned long long iterations) {
+    _Wheel *wheel = state;
+    unsigned long long sum = 0;
+    for (unsigned long long i = 0; i < iterations; i++) {
+        sum += (unsigned long long)(size_t)get_random_individual(&wheel->random, wheel->ranks, wheel->size);
+    }
+    return sum;
+}
+
+static unsigned long long _bench_clone(void *state, unsigned long long iterations) {
+    const Individual *individual = state;
+    unsigned long long sum = 0;
+    for (unsigned long long i = 0; i < iterations; i++) {
+        Individual *clone = ga_individual_clone(individual);
+        sum += ((const unsigned char *)clone->genome)[i % clone->size];
+        ga_individual_destroy(clone);
+    }
+    return sum;
+}
+
+/**
+ * The state of the generation benchmark.
+ */
+typedef struct {
+    Solver *solver;
+    Population *population;
+    unsigned int length;
+} _Generation;
+
+/**
+ * Rates a genome by the sum of its chromosomes, cheap enough for the benchmark to measure the algorithm.
+ * @param genome the genome.
+ * @param problem the number of chromosomes.
+ * @return the rating.
+ */
+static unsigned int _sum(const void *genome, const void *problem) {
+    const unsigned char *chromosomes = genome;
+    unsigned int length = *(const unsigned int *)problem;
+    unsigned int note = 0;
+    for (unsigned int i = 0; i < length; i++) {
+        note += chromosomes[i];
+    }
+    return note;
+}
+
+static unsigned long long _bench_next(void *state, unsigned long long iterations) {
+    _Generation *generation = state;
+    for (unsigned long long i = 0; i < iterations; i++) {
+        ga_population_next(generation->solver, generation->population, 0.5f, 0.01f, _sum, &generation->length);
+    }
+    return get_best_score(generation->solver);
+}
+
+/**
+ * Reads the puzzle of BENCH_PUZZLE.
+ * @param cells the storage of the 81 cells.
+ */
+static void _puzzle(unsigned int *cells) {
+    for (unsigned int i = 0; i < 81; i++) {
+        cells[i] = BENCH_PUZZLE[i] == '.' ? 0 : (unsigned int)(BENCH_PUZZLE[i] - '0');
+    }
+}
+
+/**
+ * Runs the micro-benchmarks: the sudoku fitness kernels, a spin of the fortune wheel, the cloning of a genome
+ * and a generation of populations of 100 to 1M individuals with genomes of various lengths.
+ * @return whether the benchmarks could be set up.
+ */
+static bool _micro(void) {
+    static const unsigned int sizes[] = {100, 1000, 10000, 100000, 1000000};
+    static const unsigned int lengths[] = {16, 81, 256};
+    unsigned int cells[81];
+    unsigned char grid[81];
+    Random random;
+    _puzzle(cells);
+    Sudoku *sudoku = sudoku_create(cells);
+    GeneticGenerator *generator = sudoku ? sudoku_generator(sudoku) : NULL;
+    if (!generator) {
+        return false;
+    }
+    ga_random_seed(&random, 0, 0);
+    unsigned char *genome = genetic_generator_individual(generator);
+    sudoku_decode(sudoku, genome, grid);
+    _Fitness compact = {fitness, grid, cells, 81};
+    _bench("fitness", 0, 81, _bench_fitness, &compact);
+    _Fitness encoded = {sudoku_fitness, genome, sudoku, sudoku->size};
+    _bench("sudoku_fitness", 0, sudoku->size, _bench_fitness, &encoded);
+    ga_free(genome);
+    genetic_generator_destroy(generator);
+    sudoku_destroy(sudoku);
+
+    for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        _Wheel wheel = {malloc(sizeof(Fortune_Rank) * sizes[s]), sizes[s], random};
+        unsigned long long sum = 0;
+        if (!wheel.ranks) {
+            return false;
+        }
+        for (unsigned int i = 0; i < wheel.size; i++) {
+            wheel.ranks[i].individual = (Individual *)(size_t)i;
+            wheel.ranks[i].note = ga_random_number(&random, 100);
+            sum += wheel.ranks[i].note;
+        }
+        ga_fortune_wheel_build(wheel.ranks, wheel.size, sum);
+        _bench("get_random_individual", wheel.size, 0, _bench_wheel, &wheel);
+        free(wheel.ranks);
+    }
+
+    for (unsigned int l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        generator = genetic_generator_create(lengths[l]);
+        for (unsigned int i = 0; i < lengths[l]; i++) {
+            genetic_generator_set_cardinality(generator, i, 9);
+        }
+        Individual individual = {0, genetic_generator_individual(generator), lengths[l], 1};
+        _bench("ga_individual_clone", 0, lengths[l], _bench_clone, &individual);
+        ga_free(individual.genome);
+        for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            if (2ULL * sizes[s] * lengths[l] > BENCH_MAX_BYTES) {
+                continue;
+            }
+            _Generation generation = {ga_solver_create(0), NULL, lengths[l]};
+            generation.population = ga_population_create(generation.solver, generator, sizes[s]);
+            if (!generation.population) {
+                ga_solver_destroy(generation.solver);
+                genetic_generator_destroy(generator);
+                return false;
+            }
+            /* the first generation allocates the storage reused by the next ones */
+            _bench_next(&generation, 1);
+            _bench("ga_population_next", sizes[s], lengths[l], _bench_next, &generation);
+            ga_population_destroy(generation.population);
+            ga_solver_destroy(generation.solver);
+        }
+        genetic_generator_destroy(generator);
+    }
+    return true;
+}
+
+/**
+ * Runs the macro-benchmark: solves each puzzle with BENCH_SEEDS random streams on one worker, with the
+ * settings of the sudoku binary, and writes the time-to-solve statistics as a JSON line.
+ * @param puzzles the puzzles (81 cells each).
+ * @param count the number of puzzles.
+ * @return whether the puzzles could be solved.
+ */
+static bool _macro(const unsigned int *puzzles, unsigned int count) {
+    BatchSettings settings = {.cross_over = 0.5f, .mutation = 0.01f, .individuals = 1000, .generations = 1000,
+                              .workers = 1, .local_search = SUDOKU_LOCAL_SEARCH_FRACTION,
+                              .cross_over_operator = sudoku_cross_over_guided, .cache = SUDOKU_CACHE_CAPACITY};
+    unsigned int total = count * BENCH_SEEDS;
+    unsigned int *runs = malloc(sizeof(unsigned int) * 81 * total);
+    BatchResult *results = malloc(sizeof(BatchResult) * total);
+    double *durations = NULL;
+    unsigned long long generations = 0;
+    unsigned int solved = 0;
+    double elapsed = 0;
+    bool done = runs && results;
+    if (done) {
+        /* the random stream of a run is its index */
+        for (unsigned int i = 0; i < total; i++) {
+            memcpy(runs + 81 * i, puzzles + 81 * (i % count), sizeof(unsigned int) * 81);
+        }
+        elapsed = _now();
+        done = sudoku_batch_solve(runs, total, &settings, results, NULL);
+        elapsed = _now() - elapsed;
+    }
+    if (done) {
+        /* the percentiles of sudoku_batch_summary */
+        durations = sudoku_batch_durations(results, total);
+        done = durations != NULL;
+    }
+    if (done) {
+        for (unsigned int i = 0; i < total; i++) {
+            solved += !results[i].score;
+            generations += results[i].generations;
+        }
+        printf("{\"suite\": \"macro\", \"benchmark\": \"solve\", \"puzzles\": %u, \"seeds\": %u, \"solved\": %u, "
+               "\"seconds\": %.6f, \"mean_generations\": %.1f, \"p50_ms\": %.3f, \"p90_ms\": %.3f, "
+               "\"max_ms\": %.3f}\n",
+               count, BENCH_SEEDS, solved, elapsed, (double)generations / total,
+               sudoku_batch_percentile(durations, total, 500) * 1e3,
+               sudoku_batch_percentile(durations, total, 900) * 1e3, durations[total - 1] * 1e3);
+    }
+    free(durations);
+    free(results);
+    free(runs);
+    return done;
+}
+
+/**
+ * Benchmarks the library and writes a JSON line per result, to diff between commits (a debug build of the
+ * library adds its own lines, which do not start with a brace). Every random draw is seeded, so only the
+ * timings change from a run to another.
+ * Usage: ga-bench [micro|macro] [puzzle file]
+ */
+int main(int argc, char **argv) {
+    const char *suite = argc > 1 ? argv[1] : "all";
+    unsigned int cells[81];
+    unsigned int *puzzles = cells;
+    unsigned int count = 1;
+    bool done = true;
+    if (strcmp(suite, "all") && strcmp(suite, "micro") && strcmp(suite, "macro")) {
+        fputs("Usage: ga-bench [micro|macro] [puzzle file]\n", stderr);
+        return EXIT_FAILURE;
+    }
+    ga_init();
+    ga_seed(0);
+    if (strcmp(suite, "macro")) {
+        done = _micro();
+    }
+    if (done && strcmp(suite, "micro")) {
+        _puzzle(cells);
+        if (argc > 2) {
+            FILE *stream = fopen(argv[2], "r");
+            puzzles = stream ? sudoku_batch_read(stream, &count) : NULL;
+            if (stream) {
+                fclose(stream);
+            }
+        }
+        done = puzzles && count && _macro(puzzles, count);
+        if (puzzles != cells) {
+            free(puzzles);
+        }
+    }
+    ga_finish();
+    if (!done) {
+        fputs("Failed to run the benchmarks!\n", stderr);
+    }
+    return done ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,23 +1,156 @@
 #include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <unistd.h>
 
 #include "./ga.h"
 #include "./ga.inc"
 
+/**
+ * The allocations counted while a generation is bred, from every thread working on it.
+ */
+typedef struct {
+    atomic_ullong allocations;
+    atomic_ullong bytes;
+} _Allocations;
+
+#if GA_INSTRUMENTATION
+static void *_default_malloc(size_t size);
+static void *_default_realloc(void *ptr, size_t size);
+
+void *(*ga_malloc)(size_t size) = _default_malloc;
+void *(*ga_realloc)(void *ptr, size_t size) = _default_realloc;
+#else
 void *(*ga_malloc)(size_t size) = malloc;
 void *(*ga_realloc)(void *ptr, size_t size) = realloc;
+#endif
 void (*ga_free)(void *ptr) = free;
 
+#if GA_INSTRUMENTATION
+/**
+ * The counters of the generation the thread is working on, NULL if none is instrumented.
+ */
+static _Thread_local _Allocations *thread_allocations = NULL;
+
+/**
+ * Counts an allocation in the generation the thread is working on.
+ * @param size the number of bytes.
+ */
+static inline void _count_allocation(size_t size) {
+    if (thread_allocations) {
+        atomic_fetch_add_explicit(&thread_allocations->allocations, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&thread_allocations->bytes, size, memory_order_relaxed);
+    }
+}
+
+/**
+ * The default ga_malloc: malloc, counting the allocations of the library and of the functions it calls back.
+ * @param size the number of bytes.
+ * @return the memory or NULL.
+ */
+static void *_default_malloc(size_t size) {
+    _count_allocation(size);
+    return malloc(size);
+}
+
+/**
+ * The default ga_realloc: realloc, counting the allocations of the library and of the functions it calls back.
+ * @param ptr the memory.
+ * @param size the new number of bytes.
+ * @return the memory or NULL.
+ */
+static void *_default_realloc(void *ptr, size_t size) {
+    _count_allocation(size);
+    return realloc(ptr, size);
+}
+
+/**
+ * Allocates memory with ga_malloc, counting the allocation for the instrumentation even with a custom allocator.
+ * @param size the number of bytes.
+ * @return the memory or NULL.
+ */
+static void *_counted_malloc(size_t size) {
+    if (ga_malloc != _default_malloc) {
+        _count_allocation(size);
+    }
+    return (ga_malloc)(size);
+}
+
+/**
+ * Reallocates memory with ga_realloc, counting the allocation for the instrumentation even with a custom
+ * allocator.
+ * @param ptr the memory.
+ * @param size the new number of bytes.
+ * @return the memory or NULL.
+ */
+static void *_counted_realloc(void *ptr, size_t size) {
+    if (ga_realloc != _default_realloc) {
+        _count_allocation(size);
+    }
+    return (ga_realloc)(ptr, size);
+}
+
+#define ga_malloc(size) _counted_malloc(size)
+#define ga_realloc(ptr, size) _counted_realloc(ptr, size)
+#endif
+
+/**
+ * Gets the counters of the generation the thread is working on, for the threads helping it.
+ * @return the counters or NULL.
+ */
+static inline _Allocations *_allocations_current(void) {
+#if GA_INSTRUMENTATION
+    return thread_allocations;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * Makes the thread count its allocations in the counters of a generation.
+ * @param allocations the counters (NULL to stop counting).
+ * @return the counters the thread used before.
+ */
+static inline _Allocations *_allocations_attach(_Allocations *allocations) {
+#if GA_INSTRUMENTATION
+    _Allocations *previous = thread_allocations;
+    thread_allocations = allocations;
+    return previous;
+#else
+    (void)allocations;
+    return NULL;
+#endif
+}
+
 #define MIN(a,b) (((a)<(b))?(a):(b))
+#define MAX(a,b) (((a)>(b))?(a):(b))
+
+/**
+ * The number of steps per chromosome allowed to arrange a permutation segment within the domains.
+ */
+#define GA_ARRANGE_STEPS 64
+#define GA_ALIGNMENT 64
+#define GA_CHECKPOINT_MAGIC 0x4B434147u /* "GACK" */
+#define GA_CHECKPOINT_ALIGNMENT 4096
+#define GA_CHUNKS_PER_THREAD 4
+#define GA_GENERATOR_MAGIC 0x4E474147u /* "GAGN" */
+#define GA_NO_PARENT ((unsigned int)-1)
 
 static int counter = 0;
-static int gen_counter = 1;
-static int low_score = 999999;
-static Individual *low_individual;
+
+static unsigned long long random_seed = 0;
+static atomic_uint random_streams = 1;
+static atomic_uint random_epoch = 1;
+static _Thread_local Random thread_random;
+static _Thread_local unsigned int thread_epoch = 0;
 
 /**
  * Initializes the library
@@ -25,7 +158,9 @@ static Individual *low_individual;
  */
 bool ga_init(void) {
     if (!counter++) {
-        srand(time(NULL));
+        if (atomic_load(&random_epoch) == 1) {
+            ga_seed((unsigned long long)time(NULL));
+        }
         assert(printf("GA initialised\n"));
     }
     return true;
@@ -55,6 +190,10 @@ GeneticGenerator *genetic_generator_create(const unsigned int size) {
     GeneticGenerator *generator = ga_malloc(sizeof *generator);
     if (generator) {
         generator->size = size;
+        generator->segments = NULL;
+        generator->segment_values = NULL;
+        generator->domain_offsets = NULL;
+        generator->domain_values = NULL;
         if (size) {
             generator->cardinalities = ga_malloc(sizeof(unsigned int) * size);
             if (!generator->cardinalities) {
@@ -75,6 +214,10 @@ GeneticGenerator *genetic_generator_create(const unsigned int size) {
  * @param generator the generator.
  */
 void genetic_generator_destroy(GeneticGenerator *generator) {
+    ga_free(generator->domain_values);
+    ga_free(generator->domain_offsets);
+    ga_free(generator->segment_values);
+    ga_free(generator->segments);
     ga_free(generator->cardinalities);
     ga_free(generator);
 }
@@ -104,6 +247,126 @@ unsigned int genetic_generator_get_cardinality(const GeneticGenerator *generator
     return generator->cardinalities[index];
 }
 
+/**
+ * Makes consecutive chromosomes a permutation segment: they hold a permutation of the given values, drawn at
+ * random on initialisation, exchanged as a whole by cross-overs and swapped with each other by mutations.
+ * The cardinalities of the chromosomes are raised to the values if needed.
+ * @param generator the generator.
+ * @param begin the position of the first chromosome of the segment.
+ * @param length the number of chromosomes of the segment.
+ * @param values the values permuted by the segment (length values).
+ * @return the generator or NULL if the segment overlaps another one or cannot be stored.
+ */
+GeneticGenerator *genetic_generator_set_segment(GeneticGenerator *generator, const unsigned int begin,
+                                                const unsigned int length, const unsigned int *values) {
+    assert(begin + length <= generator->size);
+    if (!length) {
+        return generator;
+    }
+    if (!generator->segments) {
+        generator->segments = ga_malloc(sizeof(unsigned int) * generator->size);
+        generator->segment_values = ga_malloc(sizeof(unsigned int) * generator->size);
+        if (!generator->segments || !generator->segment_values) {
+            ga_free(generator->segments);
+            ga_free(generator->segment_values);
+            generator->segments = NULL;
+            generator->segment_values = NULL;
+            return NULL;
+        }
+        memset(generator->segments, 0, sizeof(unsigned int) * generator->size);
+        memset(generator->segment_values, 0, sizeof(unsigned int) * generator->size);
+    }
+    for (unsigned int index = 0; index < begin + length; index += MAX(generator->segments[index], 1)) {
+        if (generator->segments[index] && index + generator->segments[index] > begin) {
+            return NULL;
+        }
+    }
+    generator->segments[begin] = length;
+    for (unsigned int index = 0; index < length; index++) {
+        generator->segment_values[begin + index] = values[index];
+        generator->cardinalities[begin + index] = MAX(generator->cardinalities[begin + index], values[index]);
+    }
+    return generator;
+}
+
+/**
+ * Gets the length of the permutation segment starting at a chromosome.
+ * @param generator the generator.
+ * @param index the position of the chromosome.
+ * @return the length of the segment (0 if no segment starts at the chromosome).
+ */
+unsigned int genetic_generator_get_segment(const GeneticGenerator *generator, const unsigned int index) {
+    assert(index < generator->size);
+    return generator->segments ? generator->segments[index] : 0;
+}
+
+/**
+ * Restricts the values a chromosome may take to a set: initialisations and mutations draw the chromosome among
+ * them, and a mutation only swaps chromosomes of a permutation segment if both values stay in their domains.
+ * The domains are stored as sparse lists, one after the other. The cardinality of the chromosome is raised to
+ * the values if needed.
+ * @param generator the generator.
+ * @param index the position of the chromosome.
+ * @param values the allowed values.
+ * @param count the number of allowed values (0 to allow every value up to the cardinality).
+ * @return the generator or NULL if the domain cannot be stored.
+ */
+GeneticGenerator *genetic_generator_set_domain(GeneticGenerator *generator, const unsigned int index,
+                                               const unsigned int *values, const unsigned int count) {
+    unsigned int *domain_values;
+    unsigned int previous;
+    unsigned int total;
+    assert(index < generator->size);
+    if (!generator->domain_offsets) {
+        if (!count) {
+            return generator;
+        }
+        generator->domain_offsets = ga_malloc(sizeof(unsigned int) * (generator->size + 1));
+        if (!generator->domain_offsets) {
+            return NULL;
+        }
+        memset(generator->domain_offsets, 0, sizeof(unsigned int) * (generator->size + 1));
+    }
+    previous = generator->domain_offsets[index + 1] - generator->domain_offsets[index];
+    total = generator->domain_offsets[generator->size];
+    if (count > previous) {
+        domain_values = ga_realloc(generator->domain_values, sizeof(unsigned int) * (total - previous + count));
+        if (!domain_values) {
+            return NULL;
+        }
+        generator->domain_values = domain_values;
+    }
+    memmove(generator->domain_values + generator->domain_offsets[index] + count,
+            generator->domain_values + generator->domain_offsets[index + 1],
+            sizeof(unsigned int) * (total - generator->domain_offsets[index + 1]));
+    for (unsigned int i = 0; i < count; i++) {
+        generator->domain_values[generator->domain_offsets[index] + i] = values[i];
+        generator->cardinalities[index] = MAX(generator->cardinalities[index], values[i]);
+    }
+    for (unsigned int i = index + 1; i <= generator->size; i++) {
+        generator->domain_offsets[i] = generator->domain_offsets[i] + count - previous;
+    }
+    return generator;
+}
+
+/**
+ * Gets the values a chromosome may take.
+ * @param generator the generator.
+ * @param index the position of the chromosome.
+ * @param count the number of allowed values (0 if every value up to the cardinality is allowed).
+ * @return the allowed values.
+ */
+const unsigned int *genetic_generator_get_domain(const GeneticGenerator *generator, const unsigned int index,
+                                                 unsigned int *count) {
+    assert(index < generator->size);
+    if (!generator->domain_offsets) {
+        *count = 0;
+        return NULL;
+    }
+    *count = generator->domain_offsets[index + 1] - generator->domain_offsets[index];
+    return generator->domain_values + generator->domain_offsets[index];
+}
+
 /**
  * Gets the size of the generator
  * @param generator the generator
@@ -121,7 +384,10 @@ unsigned int genetic_generator_get_size(const GeneticGenerator *generator) {
 GeneticGenerator *genetic_generator_clone(const GeneticGenerator *generator) {
     GeneticGenerator *clone = genetic_generator_create(generator->size);
     if (clone) {
-        memcpy(clone->cardinalities, generator->cardinalities, generator->size * sizeof(unsigned int));
+        if (!genetic_generator_copy(clone, generator)) {
+            genetic_generator_destroy(clone);
+            return NULL;
+        }
         return clone;
     } else {
         return NULL;
@@ -136,26 +402,85 @@ GeneticGenerator *genetic_generator_clone(const GeneticGenerator *generator) {
  * @return the position of the copied generator.
  */
 GeneticGenerator *genetic_generator_copy(GeneticGenerator *dest, const GeneticGenerator *src) {
-    unsigned int *cardinalities = ga_realloc(dest->cardinalities, src->size * sizeof(unsigned int));
-    if (cardinalities) {
-        dest->size = src->size;
-        dest->cardinalities = cardinalities;
-        memcpy(dest->cardinalities, src->cardinalities, src->size * sizeof(unsigned int));
-        return dest;
-    } else {
+    unsigned int *cardinalities;
+    unsigned int *segments = NULL;
+    unsigned int *segment_values = NULL;
+    unsigned int *domain_offsets = NULL;
+    unsigned int *domain_values = NULL;
+    if (src->segments) {
+        segments = ga_malloc(src->size * sizeof(unsigned int));
+        segment_values = ga_malloc(src->size * sizeof(unsigned int));
+        if (!segments || !segment_values) {
+            ga_free(segments);
+            ga_free(segment_values);
+            return NULL;
+        }
+        memcpy(segments, src->segments, src->size * sizeof(unsigned int));
+        memcpy(segment_values, src->segment_values, src->size * sizeof(unsigned int));
+    }
+    if (src->domain_offsets) {
+        unsigned int total = src->domain_offsets[src->size];
+        domain_offsets = ga_malloc((src->size + 1) * sizeof(unsigned int));
+        /* every domain may have been cleared: no values to copy */
+        domain_values = total ? ga_malloc(total * sizeof(unsigned int)) : NULL;
+        if (!domain_offsets || (total && !domain_values)) {
+            ga_free(domain_offsets);
+            ga_free(domain_values);
+            ga_free(segments);
+            ga_free(segment_values);
+            return NULL;
+        }
+        memcpy(domain_offsets, src->domain_offsets, (src->size + 1) * sizeof(unsigned int));
+        if (total) {
+            memcpy(domain_values, src->domain_values, total * sizeof(unsigned int));
+        }
+    }
+    cardinalities = ga_realloc(dest->cardinalities, src->size * sizeof(unsigned int));
+    if (src->size && !cardinalities) {
+        ga_free(domain_offsets);
+        ga_free(domain_values);
+        ga_free(segments);
+        ga_free(segment_values);
         return NULL;
     }
+    dest->cardinalities = cardinalities;
+    ga_free(dest->segments);
+    ga_free(dest->segment_values);
+    ga_free(dest->domain_offsets);
+    ga_free(dest->domain_values);
+    dest->size = src->size;
+    dest->segments = segments;
+    dest->segment_values = segment_values;
+    dest->domain_offsets = domain_offsets;
+    dest->domain_values = domain_values;
+    memcpy(dest->cardinalities, src->cardinalities, src->size * sizeof(unsigned int));
+    return dest;
 }
 
 /**
- * Writes a generator to a file given in parameter.
+ * Writes a generator to a file given in parameter: a magic word and the version of the format, its size, its
+ * cardinalities and, behind a flag, the lengths and the values of its permutation segments then, behind another
+ * flag, the offsets and the values of the domains of its chromosomes.
  * @param generator the generator to write in a file
  * @param stream the destination file.
  * @return the generator that has been written in the file.
  */
 GeneticGenerator *genetic_generator_fwrite(const GeneticGenerator *generator, FILE *stream) {
-    if (fwrite(&generator->size, sizeof(generator->size), 1, stream) == 1 &&
-        fwrite(generator->cardinalities, sizeof(unsigned int), generator->size, stream) == generator->size) {
+    const unsigned int header[2] = {GA_GENERATOR_MAGIC, GA_GENERATOR_VERSION};
+    unsigned int segmented = generator->segments != NULL;
+    unsigned int restricted = generator->domain_offsets != NULL;
+    unsigned int total = restricted ? generator->domain_offsets[generator->size] : 0;
+    if (fwrite(header, sizeof(unsigned int), 2, stream) == 2 &&
+        fwrite(&generator->size, sizeof(generator->size), 1, stream) == 1 &&
+        fwrite(generator->cardinalities, sizeof(unsigned int), generator->size, stream) == generator->size &&
+        fwrite(&segmented, sizeof(segmented), 1, stream) == 1 &&
+        (!segmented ||
+         (fwrite(generator->segments, sizeof(unsigned int), generator->size, stream) == generator->size &&
+          fwrite(generator->segment_values, sizeof(unsigned int), generator->size, stream) == generator->size)) &&
+        fwrite(&restricted, sizeof(restricted), 1, stream) == 1 &&
+        (!restricted ||
+         (fwrite(generator->domain_offsets, sizeof(unsigned int), generator->size + 1, stream) == generator->size + 1 &&
+          fwrite(generator->domain_values, sizeof(unsigned int), total, stream) == total))) {
         return (GeneticGenerator *)generator;
     } else {
         return NULL;
@@ -163,32 +488,136 @@ GeneticGenerator *genetic_generator_fwrite(const GeneticGenerator *generator, FI
 }
 
 /**
- * Reads a generator in a file.
+ * Tells whether permutation segments read in a file fit a genome: they follow each other up to its end without
+ * overlapping, and permute values allowed by the cardinalities of their chromosomes.
+ * @param size the number of chromosomes.
+ * @param cardinalities the cardinalities of the chromosomes.
+ * @param segments the length of the segment starting at each chromosome (0 if none).
+ * @param segment_values the values permuted by the segments.
+ * @return whether the segments are valid.
+ */
+static bool _segments_valid(unsigned int size, const unsigned int *cardinalities, const unsigned int *segments,
+                            const unsigned int *segment_values) {
+    unsigned int index = 0;
+    while (index < size) {
+        unsigned int length = segments[index];
+        if (length > size - index) {
+            return false;
+        }
+        for (unsigned int i = index; i < index + length; i++) {
+            if ((i > index && segments[i]) || segment_values[i] < 1 || segment_values[i] > cardinalities[i]) {
+                return false;
+            }
+        }
+        if (!length && segment_values[index]) {
+            return false;
+        }
+        index += MAX(length, 1);
+    }
+    return true;
+}
+
+/**
+ * Reads the domains of the chromosomes of a generator in a file.
+ * @param size the number of chromosomes.
+ * @param cardinalities the cardinalities of the chromosomes, bounding the values of their domains.
+ * @param pdomain_offsets the offsets of the domains read.
+ * @param pdomain_values the values of the domains read.
+ * @param stream the file.
+ * @return whether valid domains could be read.
+ */
+static bool _domains_fread(unsigned int size, const unsigned int *cardinalities, unsigned int **pdomain_offsets,
+                           unsigned int **pdomain_values, FILE *stream) {
+    unsigned int *domain_offsets = ga_malloc(sizeof(unsigned int) * (size + 1));
+    unsigned int *domain_values = NULL;
+    if (domain_offsets && fread(domain_offsets, sizeof(unsigned int), size + 1, stream) == size + 1) {
+        bool valid = domain_offsets[0] == 0;
+        for (unsigned int i = 0; i < size && valid; i++) {
+            valid = domain_offsets[i] <= domain_offsets[i + 1];
+        }
+        unsigned int total = domain_offsets[size];
+        domain_values = valid && total ? ga_malloc(sizeof(unsigned int) * total) : NULL;
+        valid = valid && (!total || (domain_values &&
+                                     fread(domain_values, sizeof(unsigned int), total, stream) == total));
+        for (unsigned int i = 0; i < size && valid; i++) {
+            for (unsigned int j = domain_offsets[i]; j < domain_offsets[i + 1] && valid; j++) {
+                valid = domain_values[j] >= 1 && domain_values[j] <= cardinalities[i];
+            }
+        }
+        if (valid) {
+            *pdomain_offsets = domain_offsets;
+            *pdomain_values = domain_values;
+            return true;
+        }
+    }
+    ga_free(domain_values);
+    ga_free(domain_offsets);
+    return false;
+}
+
+/**
+ * Reads a generator in a file. Files written before the format had a magic word only hold the size and the
+ * cardinalities, and are still read.
  * @param generator the generator to read
  * @param stream the file in whitch the generator is supposed to be.
- * @return the generator if found.
+ * @return the generator if found and valid.
  */
 GeneticGenerator *genetic_generator_fread(GeneticGenerator *generator, FILE *stream) {
     unsigned int size;
-    unsigned int *cardinalities;
-    if (fread(&size, sizeof(size), 1, stream) == 1) {
-        cardinalities = ga_malloc(sizeof(unsigned int) * size);
-        if (cardinalities) {
-            if (fread(cardinalities, sizeof(unsigned int), size, stream) == size) {
-                ga_free(generator->cardinalities);
-                generator->size = size;
-                generator->cardinalities = cardinalities;
-                return generator;
-            } else {
-                ga_free(cardinalities);
-                return NULL;
-            }
-        } else {
+    unsigned int version = 0;
+    unsigned int segmented = 0;
+    unsigned int restricted = 0;
+    unsigned int *cardinalities = NULL;
+    unsigned int *segments = NULL;
+    unsigned int *segment_values = NULL;
+    unsigned int *domain_offsets = NULL;
+    unsigned int *domain_values = NULL;
+    if (fread(&size, sizeof(size), 1, stream) != 1) {
+        return NULL;
+    }
+    if (size == GA_GENERATOR_MAGIC) {
+        if (fread(&version, sizeof(version), 1, stream) != 1 || version != GA_GENERATOR_VERSION ||
+            fread(&size, sizeof(size), 1, stream) != 1) {
             return NULL;
         }
-    } else {
+    }
+    cardinalities = ga_malloc(sizeof(unsigned int) * size);
+    if ((size && !cardinalities) || fread(cardinalities, sizeof(unsigned int), size, stream) != size ||
+        (version && (fread(&segmented, sizeof(segmented), 1, stream) != 1 || segmented > 1))) {
+        ga_free(cardinalities);
+        return NULL;
+    }
+    if (segmented) {
+        segments = ga_malloc(sizeof(unsigned int) * size);
+        segment_values = ga_malloc(sizeof(unsigned int) * size);
+        if (!segments || !segment_values || fread(segments, sizeof(unsigned int), size, stream) != size ||
+            fread(segment_values, sizeof(unsigned int), size, stream) != size ||
+            !_segments_valid(size, cardinalities, segments, segment_values)) {
+            ga_free(segment_values);
+            ga_free(segments);
+            ga_free(cardinalities);
+            return NULL;
+        }
+    }
+    if ((version && (fread(&restricted, sizeof(restricted), 1, stream) != 1 || restricted > 1)) ||
+        (restricted && !_domains_fread(size, cardinalities, &domain_offsets, &domain_values, stream))) {
+        ga_free(segment_values);
+        ga_free(segments);
+        ga_free(cardinalities);
         return NULL;
     }
+    ga_free(generator->domain_values);
+    ga_free(generator->domain_offsets);
+    ga_free(generator->segment_values);
+    ga_free(generator->segments);
+    ga_free(generator->cardinalities);
+    generator->size = size;
+    generator->cardinalities = cardinalities;
+    generator->segments = segments;
+    generator->segment_values = segment_values;
+    generator->domain_offsets = domain_offsets;
+    generator->domain_values = domain_values;
+    return generator;
 }
 
 /**
@@ -248,240 +677,3220 @@ const char *genetic_generator_to_string(const GeneticGenerator *generator) {
 }
 
 /**
- * Generates an individual with a number of chromosomes.
- * @param generator the generator
- * @return the generated individual.
+ * Runs the chunks of the current job of a thread pool until none is left.
+ * @param pool the thread pool.
  */
-unsigned int* genetic_generator_individual(const GeneticGenerator* generator){
-    unsigned int *individual = malloc(sizeof(unsigned int) * generator->size);
-    for(int i = 0; i < generator->size; i++){
-        int max = (int)genetic_generator_get_cardinality(generator, i);
-        individual[i] = random_number(1, max);
+static void _thread_pool_work(ThreadPool *pool) {
+    unsigned int begin;
+    while ((begin = atomic_fetch_add(&pool->next, pool->chunk)) < pool->count) {
+        pool->task(pool->arg, begin, MIN(begin + pool->chunk, pool->count));
     }
-    return individual;
 }
 
 /**
- * Creates a population of individuals.
- * @param generator the generator.
- * @param size the size of the population.
- * @return the population.
+ * The loop of a worker thread: waits for a job, works on it, and signals its completion.
+ * @param arg the thread pool.
+ * @return NULL.
  */
-Population* ga_population_create(const GeneticGenerator* generator, unsigned int size){
-    Population *population = ga_malloc(sizeof(Population));
-    population->genetic_generator = genetic_generator_clone(generator);;
-    population->size = size;
-    if (size && (size % 2 == 0)){
-        population->individuals = ga_malloc(sizeof(Individual) * size);
-        if (!population->individuals){
-            ga_population_destroy(population);
-        } else {
-            for(int i = 0; i < size; i++){
-                Individual *individual = ga_malloc(sizeof(Individual));
-                unsigned int *genome = genetic_generator_individual(population->genetic_generator);
-                individual->genome = genome;
-                individual->index = -1;
-                individual->size = population->genetic_generator->size;
-                population->individuals[i] = individual;
-            }
+static void *_thread_pool_worker(void *arg) {
+    ThreadPool *pool = arg;
+    unsigned long long job = 0;
+    pthread_mutex_lock(&pool->mutex);
+    for (;;) {
+        while (!pool->stop && pool->job == job) {
+            pthread_cond_wait(&pool->start, &pool->mutex);
+        }
+        if (pool->stop) {
+            break;
+        }
+        job = pool->job;
+        pthread_mutex_unlock(&pool->mutex);
+        _thread_pool_work(pool);
+        pthread_mutex_lock(&pool->mutex);
+        if (!--pool->active) {
+            pthread_cond_signal(&pool->done);
         }
-    } else {
-        ga_population_destroy(population);
     }
-    return population;
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
 }
+
 /**
- * Frees the memory taken by a population.
- * @param population the population to destroy.
+ * Creates a thread pool. The threads are started once and reused by every job.
+ * @param threads the number of threads working on a job, the calling one included (0 for one per online
+ * processor).
+ * @return the thread pool or NULL.
  */
-void ga_population_destroy(Population* population){
-    for(int i = 0; i < population->size; i++){
-        ga_individual_destroy(population->individuals[i]);
+ThreadPool *ga_thread_pool_create(unsigned int threads) {
+    ThreadPool *pool;
+    if (!threads) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (unsigned int)online : 1;
     }
-    ga_free(population->individuals);
-    genetic_generator_destroy(population->genetic_generator);
-    ga_free(population);
+    pool = ga_malloc(sizeof(ThreadPool));
+    if (pool) {
+        pool->threads = ga_malloc(sizeof(pthread_t) * threads);
+        if (!pool->threads) {
+            ga_free(pool);
+            return NULL;
+        }
+        pthread_mutex_init(&pool->mutex, NULL);
+        pthread_cond_init(&pool->start, NULL);
+        pthread_cond_init(&pool->done, NULL);
+        pool->job = 0;
+        pool->stop = false;
+        pool->active = 0;
+        atomic_init(&pool->next, 0);
+        pool->count = 0;
+        pool->size = 1;
+        while (pool->size < threads &&
+               pthread_create(&pool->threads[pool->size - 1], NULL, _thread_pool_worker, pool) == 0) {
+            pool->size++;
+        }
+    }
+    return pool;
 }
 
 /**
- * Generates a new population
- * @param population
- * @param cross_over
- * @param mutation
- * @param evaluate
- * @param problem
- * @return
- */
-Population* ga_population_next(Population* population, const float cross_over,const float mutation,unsigned int (*evaluate)(unsigned int *, const void*),const void *problem){
-    printf("Current generation : %d\n", gen_counter);
-    Population *new_population = ga_population_clone(population);
-    Fortune_Rank *ranks = ga_malloc(sizeof(Fortune_Rank) * population->size);
-    unsigned int sum_of_fitness = 0;
-    for(int i = 0; i < population->size; i++){
-        population->individuals[i]->index = i;
-        ranks[i].individual = population->individuals[i];
-        ranks[i].note = evaluate(population->individuals[i]->genome, problem);
-        sum_of_fitness += ranks[i].note;
-        low_score = MIN(ranks[i].note, low_score);
-        if (low_score == ranks[i].note){
-            low_individual = ga_individual_clone(ranks[i].individual);
-        }
+ * Stops the threads of a thread pool and destroys it.
+ * @param pool the thread pool.
+ */
+void ga_thread_pool_destroy(ThreadPool *pool) {
+    pthread_mutex_lock(&pool->mutex);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->mutex);
+    for (unsigned int i = 0; i + 1 < pool->size; i++) {
+        pthread_join(pool->threads[i], NULL);
     }
-    for(int i = 0; i < new_population->size; i+=2){
-        Individual *mom = get_random_individual(ranks, (int)population->size, (int)sum_of_fitness);
-        Individual *dad;
-        do{
-            dad = get_random_individual(ranks, (int)population->size, (int)sum_of_fitness);
-        } while (mom->index == dad->index);
-        Individual *sister = ga_individual_clone(mom);
-        Individual *brother = ga_individual_clone(dad);
-        for(int y = 0; y < population->genetic_generator->size; y++){
-            int random_crossover = random_number(0, 100);
-            if ((int)(cross_over * 100) >= random_crossover){
-                unsigned int first_individual_chromosome = mom->genome[y];
-                unsigned int second_individual_chromosome = dad->genome[y];
-                sister->genome[y] = second_individual_chromosome;
-                brother->genome[y] = first_individual_chromosome;
-            }
-            int random_mutation = random_number(0, 100);
-            if ((int)(mutation * 100) >= random_mutation){
-                sister->genome[y] = random_number(1, 9);
-            }
-            random_mutation = random_number(0, 100);
-            if ((int)(mutation * 100) >= random_mutation){
-                brother->genome[y] = random_number(1, 9);
-            }
-        }
-        new_population->individuals[i] = sister;
-        new_population->individuals[i+1] = brother;
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->mutex);
+    ga_free(pool->threads);
+    ga_free(pool);
+}
+
+/**
+ * Gets the number of threads of a thread pool, the calling one included.
+ * @param pool the thread pool.
+ * @return the number of threads.
+ */
+unsigned int ga_thread_pool_get_size(const ThreadPool *pool) {
+    return pool->size;
+}
+
+/**
+ * Splits the range [0, count) in chunks and runs a task on them with the threads of a pool.
+ * The calling thread takes part in the job and the function returns once every chunk is done.
+ * @param pool the thread pool (NULL to run the task in the calling thread).
+ * @param task the task, called with its argument and the bounds of a chunk.
+ * @param arg the argument of the task.
+ * @param count the size of the range.
+ */
+static void _thread_pool_run(ThreadPool *pool, void (*task)(void *, unsigned int, unsigned int), void *arg,
+                             unsigned int count) {
+    if (!pool || pool->size == 1 || count < 2) {
+        task(arg, 0, count);
+        return;
+    }
+    pthread_mutex_lock(&pool->mutex);
+    pool->task = task;
+    pool->arg = arg;
+    pool->count = count;
+    pool->chunk = count / (pool->size * GA_CHUNKS_PER_THREAD);
+    if (!pool->chunk) {
+        pool->chunk = 1;
+    }
+    atomic_store(&pool->next, 0);
+    pool->active = pool->size - 1;
+    pool->job++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->mutex);
+    _thread_pool_work(pool);
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->active) {
+        pthread_cond_wait(&pool->done, &pool->mutex);
     }
-    gen_counter++;
-    printf("Best score : %d\n", low_score);
-    free(ranks);
-    ga_population_destroy(population);
-    return new_population;
+    pthread_mutex_unlock(&pool->mutex);
 }
 
 /**
- * The biased fortune wheel that will randomly select an individual (the higher the rating of the individual the higher the chance it will be selected).
- * @param fortune_rank the association of the individuals and their rating.
- * @param size the size of the wheel
- * @param sum_of_fitness the sum of every rating of every individual.
- * @return the selected individual.
+ * Gets the time elapsed since an arbitrary origin.
+ * @return the time in seconds.
  */
-Individual *get_random_individual(Fortune_Rank *ranks, int size, int sum_of_fitness){
-    float T = 0;
-    float *p_slect_array = malloc(sizeof(float) * size);
-    float *val_esp_array = malloc(sizeof(float) * size);
-    float f_sum = (float)sum_of_fitness;
-    float f_pop = (float)size;
-    for(int i = 0; i < size; i++){
-        float f_note = (float)ranks[i].note;
-        p_slect_array[i] = (1 - (f_note / f_sum));
-        val_esp_array[i] = (p_slect_array[i] * f_pop);
-        T += val_esp_array[i];
-    }
-    float r_number = random_float(0, T);
-    int individual_i = -1;
-    float sum=0;
-    for (int i = 0; i < size; i++) {
-        sum += val_esp_array[i];
-        if (sum >= r_number) {
-            individual_i = i;
-            break;
+static double _now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+/**
+ * Empties a fitness cache and its counters.
+ * @param cache the cache.
+ */
+static void _cache_clear(FitnessCache *cache) {
+    memset(cache->keys, 0, (cache->mask + 1) * sizeof(uint64_t));
+    cache->lookups = 0;
+    cache->hits = 0;
+}
+
+/**
+ * Destroys a fitness cache.
+ * @param cache the cache.
+ */
+static void _cache_destroy(FitnessCache *cache) {
+    ga_free(cache->keys);
+    ga_free(cache->notes);
+    ga_free(cache);
+}
+
+/**
+ * Creates an empty fitness cache.
+ * @param capacity the number of ratings held, rounded up to a power of two.
+ * @return the cache or NULL.
+ */
+static FitnessCache *_cache_create(unsigned int capacity) {
+    FitnessCache *cache = ga_malloc(sizeof(FitnessCache));
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    if (cache) {
+        cache->mask = size - 1;
+        cache->keys = ga_malloc(size * sizeof(uint64_t));
+        cache->notes = ga_malloc(size * sizeof(unsigned int));
+        if (!cache->keys || !cache->notes) {
+            _cache_destroy(cache);
+            return NULL;
         }
+        _cache_clear(cache);
     }
-    Individual *individual = ranks[individual_i].individual;
-    free(p_slect_array);
-    free(val_esp_array);
-    return individual;
+    return cache;
 }
 
 /**
- * clones a population.
- * @param population the population
- * @return the cloned population.
+ * Looks the rating of a genome up in a fitness cache. The cache is only read, so lookups may run in parallel.
+ * @param cache the cache.
+ * @param hash the hash of the genome.
+ * @param note the storage of the rating.
+ * @return whether the rating was found.
  */
-Population *ga_population_clone(const Population *population){
-    Population *clone = ga_population_create(population->genetic_generator, population->size);
-    if (clone) {
-        memcpy(clone->individuals, population->individuals, population->size * sizeof(Individual));
-        for(int i = 0; i < clone->size; i++){
-            clone->individuals[i] = ga_individual_clone(population->individuals[i]);
-        }
-        return clone;
-    } else {
-        return NULL;
+static inline bool _cache_lookup(const FitnessCache *cache, uint64_t hash, unsigned int *note) {
+    size_t slot = hash & cache->mask;
+    /* a null key marks an empty slot */
+    if (cache->keys[slot] != (hash | 1)) {
+        return false;
     }
+    *note = cache->notes[slot];
+    return true;
 }
 
 /**
- * clones a individual.
- * @param individual the individual to clone
- * @return the cloned individual.
+ * Records the rating of a genome in a fitness cache, in place of the one sharing its slot.
+ * @param cache the cache.
+ * @param hash the hash of the genome.
+ * @param note the rating.
  */
-Individual* ga_individual_clone(const Individual *individual){
-    Individual *clone = malloc(sizeof(Individual));
-    clone->genome = malloc(sizeof(unsigned int) * individual->size);
-    clone->size = individual->size;
-    memcpy(clone->genome, individual->genome, individual->size * sizeof(unsigned int));
-    return clone;
+static inline void _cache_insert(FitnessCache *cache, uint64_t hash, unsigned int note) {
+    size_t slot = hash & cache->mask;
+    cache->keys[slot] = hash | 1;
+    cache->notes[slot] = note;
 }
 
+/**
+ * The timer of the phases of a generation.
+ */
+typedef struct {
+    double last;
+    double phases[GA_PHASES];
+    _Allocations allocations;
+} _Clock;
 
 /**
- * Frees the memory taken by an individual.
- * @param individual the individual to destroy.
+ * Starts the timer of a generation if the solver records its statistics.
+ * @param solver the solver.
+ * @param clock the storage of the timer.
+ * @return the timer or NULL.
  */
-void ga_individual_destroy(Individual *individual){
-    ga_free(individual->genome);
-    ga_free(individual);
+static _Clock *_clock_start(const Solver *solver, _Clock *clock) {
+#if GA_INSTRUMENTATION
+    if (solver->instrumentation) {
+        memset(clock, 0, sizeof(_Clock));
+        atomic_init(&clock->allocations.allocations, 0);
+        atomic_init(&clock->allocations.bytes, 0);
+        clock->last = _now();
+        return clock;
+    }
+#else
+    (void)solver;
+    (void)clock;
+#endif
+    return NULL;
 }
 
 /**
- * Returns the best score.
- * @return the score.
+ * Charges the time elapsed since the previous lap of a timer to a phase.
+ * @param clock the timer (NULL for none).
+ * @param phase the phase.
  */
-int get_best_score(){
-    return low_score;
+static inline void _clock_lap(_Clock *clock, Phase phase) {
+    if (clock) {
+        double now = _now();
+        clock->phases[phase] += now - clock->last;
+        clock->last = now;
+    }
 }
+
 /**
- * Returns the best individual based on its result
- * @return the best individual.
+ * Records the statistics of a generation in the history of a solver and adds them to its totals.
+ * @param instrumentation the instrumentation of the solver.
+ * @param clock the timer of the generation.
+ * @param statistics the counters and the ratings of the generation.
  */
-Individual *get_best_individual(){
-    return low_individual;
+static void _instrumentation_record(Instrumentation *instrumentation, _Clock *clock,
+                                    GenerationStatistics *statistics) {
+    GenerationStatistics *total = &instrumentation->total;
+    statistics->allocations = atomic_load(&clock->allocations.allocations);
+    statistics->bytes = atomic_load(&clock->allocations.bytes);
+    memcpy(statistics->phases, clock->phases, sizeof(clock->phases));
+    instrumentation->history[instrumentation->count % instrumentation->capacity] = *statistics;
+    instrumentation->count++;
+    for (unsigned int phase = 0; phase < GA_PHASES; phase++) {
+        total->phases[phase] += statistics->phases[phase];
+    }
+    total->generation = instrumentation->count;
+    total->evaluations += statistics->evaluations;
+    total->cache_hits += statistics->cache_hits;
+    total->allocations += statistics->allocations;
+    total->bytes += statistics->bytes;
+    total->best = MIN(total->best, statistics->best);
+    total->mean += (statistics->mean - total->mean) / instrumentation->count;
+    total->worst = MAX(total->worst, statistics->worst);
 }
+
 /**
- * Returns a random int number in a given interval.
- * @param min_num the lowest number of the interval
- * @param max_num the highest number of the interval
- * @return the random number
+ * Forgets the statistics recorded by an instrumentation.
+ * @param instrumentation the instrumentation.
  */
-int random_number(int min_num, int max_num)
-{
-    int result = 0, low_num = 0, hi_num = 0;
-    if (min_num < max_num)
-    {
-        low_num = min_num;
-        hi_num = max_num + 1;
-    } else {
-        low_num = max_num + 1;
-        hi_num = min_num;
+static void _instrumentation_clear(Instrumentation *instrumentation) {
+    memset(&instrumentation->total, 0, sizeof(GenerationStatistics));
+    instrumentation->total.best = UINT_MAX;
+    instrumentation->count = 0;
+}
+
+/**
+ * Destroys an instrumentation.
+ * @param instrumentation the instrumentation.
+ */
+static void _instrumentation_destroy(Instrumentation *instrumentation) {
+    ga_free(instrumentation->history);
+    ga_free(instrumentation);
+}
+
+/**
+ * Creates a solver: the context of a run holding its generation counter, its best individual, its random
+ * generator and its evaluation settings. Solvers are independent, so several runs may share a process.
+ * @param seed the seed of the random generator of the solver.
+ * @return the solver or NULL.
+ */
+Solver *ga_solver_create(unsigned long long seed) {
+    Solver *solver = ga_malloc(sizeof(Solver));
+    if (solver) {
+        solver->generation = 1;
+        solver->best_score = UINT_MAX;
+        solver->best = NULL;
+        ga_random_seed(&solver->random, seed, 0);
+        solver->thread_pool = NULL;
+        solver->owned_pool = NULL;
+        solver->evaluate_delta = NULL;
+        solver->delta_limit = 0;
+        solver->evaluate_batch = NULL;
+        solver->progress = NULL;
+        solver->progress_interval = 1;
+        solver->progress_data = NULL;
+        solver->local_search = NULL;
+        solver->local_fraction = 0;
+        solver->local_selection = GA_LOCAL_SEARCH_BEST;
+        solver->local_time = 0;
+        solver->evaluations = 0;
+        solver->elites = 0;
+        solver->replacement = 1;
+        solver->selection = GA_SELECTION_ROULETTE;
+        solver->selection_parameter = 0;
+        solver->cross_over = NULL;
+        solver->mutation = NULL;
+        solver->cache = NULL;
+        solver->instrumentation = NULL;
     }
-    result = (rand() % (hi_num - low_num)) + low_num;
-    return result;
+    return solver;
 }
 
 /**
- * Returns a random float number in a given interval
- * @param min the lowest number of the interval
- * @param max the highest number of the interval
- * @return the random float.
+ * Forgets the run of a solver: its generation counter, its best score, its counters, its fitness cache and its
+ * statistics start over.
+ * @param solver the solver.
+ */
+static void _solver_clear(Solver *solver) {
+    solver->generation = 1;
+    solver->best_score = UINT_MAX;
+    solver->local_time = 0;
+    solver->evaluations = 0;
+    if (solver->cache) {
+        _cache_clear(solver->cache);
+    }
+    if (solver->instrumentation) {
+        _instrumentation_clear(solver->instrumentation);
+    }
+}
+
+/**
+ * Resets a solver for a new run: its generation counter and its best score start over, its fitness cache and
+ * its statistics are emptied and its random generator is reseeded. Its evaluation settings and its thread pool
+ * are kept, and so is the storage of its best individual, which is overwritten by the first generation of the
+ * new run.
+ * @param solver the solver.
+ * @param seed the seed of the random generator.
+ * @param stream the random stream, so that runs sharing a seed draw independent numbers.
+ * @return the solver.
+ */
+Solver *ga_solver_reset(Solver *solver, unsigned long long seed, unsigned long long stream) {
+    _solver_clear(solver);
+    ga_random_seed(&solver->random, seed, stream);
+    return solver;
+}
+
+/**
+ * Sets whether a solver prints the generation and the best score on each generation to the standard output,
+ * with ga_progress_print. Solvers are silent by default.
+ * @param solver the solver.
+ * @param verbose whether to print them.
+ * @return the solver.
+ */
+Solver *ga_solver_set_verbose(Solver *solver, bool verbose) {
+    return ga_solver_set_progress(solver, verbose ? ga_progress_print : NULL, 1, NULL);
+}
+
+/**
+ * Makes a solver report its progress every few generations, once they are bred. The function is called on the
+ * thread breeding the generations, so it should be quick: buffering its output rather than writing it at once.
+ * @param solver the solver.
+ * @param progress the progress function (NULL for none).
+ * @param interval the number of generations between two reports (0 is taken as 1).
+ * @param data the data given to the progress function.
+ * @return the solver.
+ */
+Solver *ga_solver_set_progress(Solver *solver, ProgressFunction progress, unsigned int interval, void *data) {
+    solver->progress = progress;
+    solver->progress_interval = MAX(interval, 1);
+    solver->progress_data = data;
+    return solver;
+}
+
+/**
+ * Prints the generation and the best score of a progress report.
+ * @param progress the progress.
+ * @param data the file (NULL for the standard output).
+ */
+void ga_progress_print(const Progress *progress, void *data) {
+    FILE *stream = data ? data : stdout;
+    fprintf(stream, "Current generation : %u\nBest score : %u\n", progress->generation, progress->best_score);
+}
+
+/**
+ * Destroys a solver, its best individual, its fitness cache, its statistics and the thread pool it owns.
+ * @param solver the solver.
+ */
+void ga_solver_destroy(Solver *solver) {
+    if (solver->best) {
+        ga_individual_destroy(solver->best);
+    }
+    if (solver->owned_pool) {
+        ga_thread_pool_destroy(solver->owned_pool);
+    }
+    if (solver->cache) {
+        _cache_destroy(solver->cache);
+    }
+    if (solver->instrumentation) {
+        _instrumentation_destroy(solver->instrumentation);
+    }
+    ga_free(solver);
+}
+
+/**
+ * Makes a solver evaluate populations in parallel with a pool of threads it creates and owns.
+ * @param solver the solver.
+ * @param threads the number of threads (0 for one per online processor, 1 to evaluate serially).
+ * @return the solver or NULL if the pool cannot be created.
+ */
+Solver *ga_solver_set_threads(Solver *solver, unsigned int threads) {
+    ThreadPool *pool = NULL;
+    if (threads != 1) {
+        pool = ga_thread_pool_create(threads);
+        if (!pool) {
+            return NULL;
+        }
+    }
+    if (solver->owned_pool) {
+        ga_thread_pool_destroy(solver->owned_pool);
+    }
+    solver->owned_pool = pool;
+    solver->thread_pool = pool;
+    return solver;
+}
+
+/**
+ * Makes a solver evaluate populations in parallel with the threads of a pool it does not own, which may be
+ * shared between solvers used one at a time.
+ * @param solver the solver.
+ * @param pool the thread pool (NULL to evaluate serially).
+ * @return the solver.
+ */
+Solver *ga_solver_set_thread_pool(Solver *solver, ThreadPool *pool) {
+    if (solver->owned_pool) {
+        ga_thread_pool_destroy(solver->owned_pool);
+        solver->owned_pool = NULL;
+    }
+    solver->thread_pool = pool;
+    return solver;
+}
+
+/**
+ * Makes a solver evaluate children incrementally. A child bred from a parent by changing at most limit
+ * chromosomes is rated by evaluate_delta from the parent genome, the parent rating and the positions of
+ * the changed chromosomes; the other individuals are rated by the evaluation function.
+ * @param solver the solver.
+ * @param evaluate_delta the incremental evaluation function (NULL to always evaluate from scratch).
+ * @param limit the maximum number of changed chromosomes worth an incremental evaluation.
+ * @return the solver.
+ */
+Solver *ga_solver_set_delta_evaluate(Solver *solver, DeltaEvaluateFunction evaluate_delta, unsigned int limit) {
+    solver->evaluate_delta = evaluate_delta;
+    solver->delta_limit = evaluate_delta ? limit : 0;
+    return solver;
+}
+
+/**
+ * Makes a solver evaluate the individuals it rates from scratch by batches of up to GA_BATCH_SIZE genomes,
+ * letting the problem score several genomes per call (with SIMD instructions for instance).
+ * Incremental evaluations still take precedence.
+ * @param solver the solver.
+ * @param evaluate_batch the batch evaluation function (NULL to evaluate one genome per call).
+ * @return the solver.
+ */
+Solver *ga_solver_set_batch_evaluate(Solver *solver, BatchEvaluateFunction evaluate_batch) {
+    solver->evaluate_batch = evaluate_batch;
+    return solver;
+}
+
+/**
+ * Makes a solver breed its children with a cross-over operator, given copies of the parents to exchange
+ * chromosomes between, the cross-over rate and the problem given to the evaluation function.
+ * @param solver the solver.
+ * @param cross_over the operator (NULL for the built-in uniform cross-over fused with the mutation).
+ * @return the solver.
+ */
+Solver *ga_solver_set_cross_over(Solver *solver, CrossOverFunction cross_over) {
+    solver->cross_over = cross_over;
+    return solver;
+}
+
+/**
+ * Makes a solver mutate its children with a mutation operator, given the mutation rate and the problem given to
+ * the evaluation function. An operator set without the other one is completed by ga_cross_over_uniform or
+ * ga_mutation_reset.
+ * @param solver the solver.
+ * @param mutation the operator (NULL for the built-in reset mutation fused with the cross-over).
+ * @return the solver.
+ */
+Solver *ga_solver_set_mutation(Solver *solver, MutationFunction mutation) {
+    solver->mutation = mutation;
+    return solver;
+}
+
+/**
+ * Sets how a solver selects the parents of its children:
+ * - GA_SELECTION_ROULETTE: the biased fortune wheel, the parameter is ignored;
+ * - GA_SELECTION_TOURNAMENT: the best of a number of random individuals, the parameter (at least 1);
+ * - GA_SELECTION_RANK: a linear ranking, the parameter being the selective pressure (from 1 to 2) that is the
+ *   expected number of picks of the best individual, the worst one being picked 2 - pressure times;
+ * - GA_SELECTION_TRUNCATION: a random individual among the best fraction of the population, the parameter.
+ * @param solver the solver.
+ * @param strategy the strategy.
+ * @param parameter the parameter of the strategy.
+ * @return the solver.
+ */
+Solver *ga_solver_set_selection(Solver *solver, SelectionStrategy strategy, float parameter) {
+    solver->selection = strategy;
+    switch (strategy) {
+        case GA_SELECTION_TOURNAMENT:
+            solver->selection_parameter = MAX(parameter, 1.0f);
+            break;
+        case GA_SELECTION_RANK:
+            solver->selection_parameter = MIN(MAX(parameter, 1.0f), 2.0f);
+            break;
+        case GA_SELECTION_TRUNCATION:
+            solver->selection_parameter = MIN(MAX(parameter, 0.0f), 1.0f);
+            break;
+        default:
+            solver->selection_parameter = 0;
+            break;
+    }
+    return solver;
+}
+
+/**
+ * Makes a solver carry the best individuals of each generation unchanged into the next one. Their ratings are
+ * kept, so they are not evaluated again as long as the evaluation function stays the same.
+ * @param solver the solver.
+ * @param elites the number of individuals carried, rounded up to an even number (0 for none).
+ * @return the solver.
+ */
+Solver *ga_solver_set_elitism(Solver *solver, unsigned int elites) {
+    solver->elites = elites;
+    return solver;
+}
+
+/**
+ * Makes a solver replace only the worst individuals of each generation by children, the others surviving
+ * unchanged with their ratings. Combined with elitism, the larger number of survivors wins.
+ * @param solver the solver.
+ * @param replacement the fraction of the population replaced (1 for a generational replacement).
+ * @return the solver.
+ */
+Solver *ga_solver_set_steady_state(Solver *solver, float replacement) {
+    solver->replacement = MIN(MAX(replacement, 0.0f), 1.0f);
+    return solver;
+}
+
+/**
+ * Makes a solver improve some individuals of each generation with a local search once they are rated and
+ * before they breed, the improved genomes and ratings replacing the original ones. The individuals are
+ * improved in parallel with the thread pool of the solver, each one with its own random generator.
+ * @param solver the solver.
+ * @param local_search the local search (NULL for none).
+ * @param fraction the fraction of the population to improve.
+ * @param selection whether the best individuals or random ones are improved.
+ * @return the solver.
+ */
+Solver *ga_solver_set_local_search(Solver *solver, LocalSearchFunction local_search, float fraction,
+                                   LocalSearchSelection selection) {
+    solver->local_search = local_search;
+    solver->local_fraction = local_search ? MIN(MAX(fraction, 0.0f), 1.0f) : 0;
+    solver->local_selection = selection;
+    return solver;
+}
+
+/**
+ * Gets the wall-clock time a solver spent in local searches since its creation or its last reset.
+ * @param solver the solver.
+ * @return the time in seconds.
+ */
+double ga_solver_get_local_search_time(const Solver *solver) {
+    return solver->local_time;
+}
+
+/**
+ * Gets the number of individuals a solver rated since its creation or its last reset.
+ * @param solver the solver.
+ * @return the number of evaluations.
+ */
+unsigned long long ga_solver_get_evaluations(const Solver *solver) {
+    return solver->evaluations;
+}
+
+/**
+ * Makes a solver remember the ratings of the genomes it evaluates, so that a child identical to an individual
+ * already rated (a parent left unchanged by the cross-over and the mutation, or a copy of a converged
+ * population) gets its rating back instead of being evaluated again. Genomes are identified by a 64-bit
+ * Zobrist hash, updated from the hash of the parent by the chromosomes that changed. The cache is direct-mapped,
+ * a rating replacing the one sharing its slot, and is only valid for one evaluation function and one problem.
+ * @param solver the solver.
+ * @param capacity the number of ratings held, rounded up to a power of two (0 for no cache).
+ * @return the solver or NULL if the cache cannot be allocated.
+ */
+Solver *ga_solver_set_cache(Solver *solver, unsigned int capacity) {
+    FitnessCache *cache = NULL;
+    if (capacity) {
+        cache = _cache_create(capacity);
+        if (!cache) {
+            return NULL;
+        }
+    }
+    if (solver->cache) {
+        _cache_destroy(solver->cache);
+    }
+    solver->cache = cache;
+    return solver;
+}
+
+/**
+ * Gets the number of children a solver looked up in its fitness cache since the cache was set or the solver reset.
+ * @param solver the solver.
+ * @return the number of lookups.
+ */
+unsigned long long ga_solver_get_cache_lookups(const Solver *solver) {
+    return solver->cache ? solver->cache->lookups : 0;
+}
+
+/**
+ * Gets the number of children whose rating a solver found in its fitness cache since the cache was set or the
+ * solver reset. They are not counted as evaluations.
+ * @param solver the solver.
+ * @return the number of hits.
+ */
+unsigned long long ga_solver_get_cache_hits(const Solver *solver) {
+    return solver->cache ? solver->cache->hits : 0;
+}
+
+/**
+ * Makes a solver record the statistics of its generations: the time spent in each phase, the evaluations, the
+ * cache hits, the memory allocated and the ratings. The statistics of the last generations are kept in a
+ * history allocated once, and the totals of every generation since the instrumentation was set or the solver
+ * reset are kept aside. Timing the phases costs a few clock reads per pair of children.
+ * @param solver the solver.
+ * @param history the number of generations kept (0 to stop recording).
+ * @return the solver or NULL if the history cannot be allocated or the library is built without
+ * instrumentation.
+ */
+Solver *ga_solver_set_instrumentation(Solver *solver, unsigned int history) {
+    Instrumentation *instrumentation = NULL;
+    if (history) {
+        if (!GA_INSTRUMENTATION) {
+            return NULL;
+        }
+        instrumentation = ga_malloc(sizeof(Instrumentation));
+        if (!instrumentation) {
+            return NULL;
+        }
+        instrumentation->history = ga_malloc(history * sizeof(GenerationStatistics));
+        if (!instrumentation->history) {
+            ga_free(instrumentation);
+            return NULL;
+        }
+        instrumentation->capacity = history;
+        _instrumentation_clear(instrumentation);
+    }
+    if (solver->instrumentation) {
+        _instrumentation_destroy(solver->instrumentation);
+    }
+    solver->instrumentation = instrumentation;
+    return solver;
+}
+
+/**
+ * Gets the statistics of a recent generation of a solver.
+ * @param solver the solver.
+ * @param age the number of generations recorded since (0 for the last one).
+ * @return the statistics or NULL if they are not kept.
+ */
+const GenerationStatistics *ga_solver_get_statistics(const Solver *solver, unsigned int age) {
+    const Instrumentation *instrumentation = solver->instrumentation;
+    if (!instrumentation || age >= MIN(instrumentation->count, instrumentation->capacity)) {
+        return NULL;
+    }
+    return &instrumentation->history[(instrumentation->count - 1 - age) % instrumentation->capacity];
+}
+
+/**
+ * Gets the totals of the statistics of a solver: the times and the counters are summed, the best and worst
+ * ratings are the extreme ones, the mean rating is the mean of the generations and the generation is the
+ * number of generations recorded.
+ * @param solver the solver.
+ * @return the totals or NULL if the solver records no statistics.
+ */
+const GenerationStatistics *ga_solver_get_total_statistics(const Solver *solver) {
+    return solver->instrumentation ? &solver->instrumentation->total : NULL;
+}
+
+/**
+ * Writes statistics as a CSV line or a JSON object.
+ * @param statistics the statistics.
+ * @param stream the file.
+ * @param format the format.
+ */
+static void _statistics_fwrite(const GenerationStatistics *statistics, FILE *stream, StatisticsFormat format) {
+    if (format == GA_STATISTICS_CSV) {
+        fprintf(stream, "%u", statistics->generation);
+        for (unsigned int phase = 0; phase < GA_PHASES; phase++) {
+            fprintf(stream, ",%.9f", statistics->phases[phase]);
+        }
+        fprintf(stream, ",%llu,%llu,%llu,%llu,%u,%.3f,%u\n", statistics->evaluations, statistics->cache_hits,
+                statistics->allocations, statistics->bytes, statistics->best, statistics->mean, statistics->worst);
+    } else {
+        fprintf(stream, "{\"generation\": %u, \"phases\": {", statistics->generation);
+        for (unsigned int phase = 0; phase < GA_PHASES; phase++) {
+            fprintf(stream, "%s\"%s\": %.9f", phase ? ", " : "", ga_phase_to_string((Phase)phase),
+                    statistics->phases[phase]);
+        }
+        fprintf(stream, "}, \"evaluations\": %llu, \"cache_hits\": %llu, \"allocations\": %llu, \"bytes\": %llu, "
+                        "\"best\": %u, \"mean\": %.3f, \"worst\": %u}",
+                statistics->evaluations, statistics->cache_hits, statistics->allocations, statistics->bytes,
+                statistics->best, statistics->mean, statistics->worst);
+    }
+}
+
+/**
+ * Writes the statistics of a solver, from the oldest generation kept to the last one: as CSV with a header
+ * line, or as a JSON object holding the generations and the totals.
+ * @param solver the solver.
+ * @param stream the file.
+ * @param format the format.
+ * @return whether the statistics could be written.
+ */
+bool ga_solver_statistics_fwrite(const Solver *solver, FILE *stream, StatisticsFormat format) {
+    const Instrumentation *instrumentation = solver->instrumentation;
+    unsigned int count;
+    if (!instrumentation) {
+        return false;
+    }
+    count = MIN(instrumentation->count, instrumentation->capacity);
+    if (format == GA_STATISTICS_CSV) {
+        fprintf(stream, "generation");
+        for (unsigned int phase = 0; phase < GA_PHASES; phase++) {
+            fprintf(stream, ",%s", ga_phase_to_string((Phase)phase));
+        }
+        fprintf(stream, ",evaluations,cache_hits,allocations,bytes,best,mean,worst\n");
+        for (unsigned int age = count; age > 0; age--) {
+            _statistics_fwrite(ga_solver_get_statistics(solver, age - 1), stream, format);
+        }
+    } else {
+        fprintf(stream, "{\"generations\": [");
+        for (unsigned int age = count; age > 0; age--) {
+            fprintf(stream, age < count ? ",\n  " : "\n  ");
+            _statistics_fwrite(ga_solver_get_statistics(solver, age - 1), stream, format);
+        }
+        fprintf(stream, "\n], \"total\": ");
+        _statistics_fwrite(&instrumentation->total, stream, format);
+        fprintf(stream, "}\n");
+    }
+    return !ferror(stream);
+}
+
+/**
+ * Names a phase of a generation.
+ * @param phase the phase.
+ * @return the name.
+ */
+const char *ga_phase_to_string(Phase phase) {
+    switch (phase) {
+        case GA_PHASE_EVALUATION:
+            return "evaluation";
+        case GA_PHASE_LOCAL_SEARCH:
+            return "local_search";
+        case GA_PHASE_SURVIVAL:
+            return "survival";
+        case GA_PHASE_SELECTION:
+            return "selection";
+        case GA_PHASE_CLONING:
+            return "cloning";
+        case GA_PHASE_CROSS_OVER:
+            return "cross_over";
+        case GA_PHASE_MUTATION:
+            return "mutation";
+        case GA_PHASE_BOOKKEEPING:
+            return "bookkeeping";
+        default:
+            return "none";
+    }
+}
+
+/**
+ * Gets the random generator of a solver.
+ * @param solver the solver.
+ * @return the random generator.
+ */
+Random *ga_solver_get_random(Solver *solver) {
+    return &solver->random;
+}
+
+/**
+ * Gets the number of the generation a solver evaluates next.
+ * @param solver the solver.
+ * @return the generation.
+ */
+unsigned int ga_solver_get_generation(const Solver *solver) {
+    return solver->generation;
+}
+
+/**
+ * Gets the number of bytes storing a chromosome of the genomes of a generator: the narrowest width holding
+ * its maximum cardinality.
+ * @param generator the generator
+ * @return the width (1, 2 or 4).
+ */
+unsigned int genetic_generator_get_width(const GeneticGenerator *generator) {
+    unsigned int max = 0;
+    for (unsigned int i = 0; i < generator->size; i++) {
+        if (generator->cardinalities[i] > max) {
+            max = generator->cardinalities[i];
+        }
+    }
+    return max <= UINT8_MAX ? 1 : max <= UINT16_MAX ? 2 : 4;
+}
+
+/**
+ * Gets a chromosome of a compact genome.
+ * @param genome the genome.
+ * @param width the width of its chromosomes.
+ * @param index the position of the chromosome.
+ * @return the chromosome.
+ */
+unsigned int ga_genome_get(const void *genome, unsigned int width, unsigned int index) {
+    switch (width) {
+        case 1:
+            return ((const uint8_t *)genome)[index];
+        case 2:
+            return ((const uint16_t *)genome)[index];
+        default:
+            return ((const uint32_t *)genome)[index];
+    }
+}
+
+/**
+ * Sets a chromosome of a compact genome.
+ * @param genome the genome.
+ * @param width the width of its chromosomes.
+ * @param index the position of the chromosome.
+ * @param value the chromosome.
+ */
+void ga_genome_set(void *genome, unsigned int width, unsigned int index, unsigned int value) {
+    switch (width) {
+        case 1:
+            ((uint8_t *)genome)[index] = (uint8_t)value;
+            break;
+        case 2:
+            ((uint16_t *)genome)[index] = (uint16_t)value;
+            break;
+        default:
+            ((uint32_t *)genome)[index] = value;
+            break;
+    }
+}
+
+/**
+ * Exchanges two chromosomes of a genome.
+ * @param genome the genome.
+ * @param width the number of bytes of a chromosome.
+ * @param first the position of the first chromosome.
+ * @param second the position of the second chromosome.
+ */
+static void _genome_swap(void *genome, unsigned int width, unsigned int first, unsigned int second) {
+    unsigned int value = ga_genome_get(genome, width, first);
+    ga_genome_set(genome, width, first, ga_genome_get(genome, width, second));
+    ga_genome_set(genome, width, second, value);
+}
+
+/**
+ * Tells whether a value belongs to the domain of a chromosome.
+ * @param generator the generator.
+ * @param index the position of the chromosome.
+ * @param value the value.
+ * @return whether the chromosome may take the value.
+ */
+static inline bool _domain_contains(const GeneticGenerator *generator, unsigned int index, unsigned int value) {
+    unsigned int begin;
+    unsigned int end;
+    if (!generator->domain_offsets) {
+        return true;
+    }
+    begin = generator->domain_offsets[index];
+    end = generator->domain_offsets[index + 1];
+    if (begin == end) {
+        return true;
+    }
+    while (begin < end && generator->domain_values[begin] != value) {
+        begin++;
+    }
+    return begin < end;
+}
+
+/**
+ * Draws a value of a chromosome: one of its domain if it has one, from 1 to its cardinality otherwise.
+ * @param generator the generator.
+ * @param index the position of the chromosome.
+ * @param random the random generator.
+ * @return the value.
+ */
+static inline unsigned int _generator_draw(const GeneticGenerator *generator, unsigned int index, Random *random) {
+    unsigned int cardinality = generator->cardinalities[index];
+    if (generator->domain_offsets) {
+        unsigned int begin = generator->domain_offsets[index];
+        unsigned int count = generator->domain_offsets[index + 1] - begin;
+        if (count) {
+            return generator->domain_values[begin + ga_random_number(random, count)];
+        }
+    }
+    return cardinality ? 1 + ga_random_number(random, cardinality) : 1;
+}
+
+/**
+ * Rearranges the shuffled values of a permutation segment so that every chromosome holds a value of its domain,
+ * by a backtracking search trying the remaining values from a random one. The search gives up after a number of
+ * steps, leaving the shuffled values as they were.
+ * @param generator the generator.
+ * @param width the number of bytes of a chromosome.
+ * @param genome the genome.
+ * @param begin the position of the first chromosome of the segment.
+ * @param index the position in the segment of the chromosome to arrange.
+ * @param length the length of the segment.
+ * @param random the random generator.
+ * @param budget the number of steps left.
+ * @return whether the chromosomes from index onwards could be arranged.
+ */
+static bool _segment_arrange(const GeneticGenerator *generator, unsigned int width, void *genome, unsigned int begin,
+                             unsigned int index, unsigned int length, Random *random, unsigned int *budget) {
+    unsigned int remaining = length - index;
+    unsigned int start;
+    if (!remaining) {
+        return true;
+    }
+    start = ga_random_number(random, remaining);
+    for (unsigned int i = 0; i < remaining && *budget; i++) {
+        unsigned int other = begin + index + (start + i) % remaining;
+        (*budget)--;
+        if (_domain_contains(generator, begin + index, ga_genome_get(genome, width, other))) {
+            _genome_swap(genome, width, begin + index, other);
+            if (_segment_arrange(generator, width, genome, begin, index + 1, length, random, budget)) {
+                return true;
+            }
+            _genome_swap(genome, width, begin + index, other);
+        }
+    }
+    return false;
+}
+
+/**
+ * Fills a genome with random chromosomes respecting the generator cardinalities, domains and permutation segments.
+ * @param generator the generator
+ * @param width the width of the chromosomes.
+ * @param genome the genome to fill (generator->size chromosomes).
+ * @param random the random generator.
+ */
+static void _generator_fill(const GeneticGenerator *generator, unsigned int width, void *genome, Random *random) {
+    for (unsigned int i = 0; i < generator->size; i++) {
+        unsigned int length = generator->segments ? generator->segments[i] : 0;
+        if (length) {
+            unsigned int budget = GA_ARRANGE_STEPS * length;
+            /* inside-out Fisher-Yates shuffle of the values of the segment */
+            for (unsigned int j = 0; j < length; j++) {
+                unsigned int k = ga_random_number(random, j + 1);
+                ga_genome_set(genome, width, i + j, ga_genome_get(genome, width, i + k));
+                ga_genome_set(genome, width, i + k, generator->segment_values[i + j]);
+            }
+            if (generator->domain_offsets) {
+                _segment_arrange(generator, width, genome, i, 0, length, random, &budget);
+            }
+            i += length - 1;
+        } else {
+            ga_genome_set(genome, width, i, _generator_draw(generator, i, random));
+        }
+    }
+}
+
+/**
+ * Generates the compact genome of an individual, its chromosomes being genetic_generator_get_width bytes wide.
+ * @param generator the generator
+ * @return the generated genome.
+ */
+void *genetic_generator_individual(const GeneticGenerator* generator){
+    unsigned int width = genetic_generator_get_width(generator);
+    void *individual = ga_malloc((size_t)width * generator->size);
+    if (individual) {
+        _generator_fill(generator, width, individual, ga_random_default());
+    }
+    return individual;
+}
+
+/**
+ * Rounds a size up to the genome matrix alignment.
+ * @param size the size in bytes.
+ * @return the aligned size.
+ */
+static size_t _align(size_t size) {
+    return (size + GA_ALIGNMENT - 1) & ~(size_t)(GA_ALIGNMENT - 1);
+}
+
+/**
+ * Allocates the arena of a population: the population header, its individuals, the fortune wheel, the
+ * random rolls of a breeding and the two genome matrices (front and back, one row of generator->size compact
+ * chromosomes per individual) are carved from a single block. The genomes are left uninitialised.
+ * @param generator the generator.
+ * @param size the size of the population.
+ * @return the population or NULL.
+ */
+static Population *_population_alloc(const GeneticGenerator *generator, unsigned int size) {
+    size_t header = sizeof(Population) + size * sizeof(Individual) + size * sizeof(Fortune_Rank) +
+                    3 * (size_t)generator->size * sizeof(unsigned int);
+    unsigned int width = genetic_generator_get_width(generator);
+    size_t matrix = _align((size_t)size * generator->size * width);
+    Population *population = ga_malloc(header + GA_ALIGNMENT - 1 + 2 * matrix);
+    if (population) {
+        population->genetic_generator = genetic_generator_clone(generator);
+        if (!population->genetic_generator) {
+            ga_free(population);
+            return NULL;
+        }
+        population->size = size;
+        population->stride = generator->size;
+        population->width = width;
+        population->row = (size_t)generator->size * width;
+        population->lineages = NULL;
+        population->changes = NULL;
+        population->delta_limit = 0;
+        population->lineages_valid = false;
+        population->hashes = NULL;
+        population->back_hashes = NULL;
+        population->hashes_valid = false;
+        population->picks = NULL;
+        population->survivors = 0;
+        population->notes = NULL;
+        population->keys = NULL;
+        population->individuals = (Individual *)(population + 1);
+        population->ranks = (Fortune_Rank *)(population->individuals + size);
+        population->rolls = (unsigned int *)(population->ranks + size);
+        population->genomes = (unsigned char *)_align((size_t)(population->rolls + 3 * (size_t)generator->size));
+        population->back = population->genomes + matrix;
+        for (unsigned int i = 0; i < size; i++) {
+            population->individuals[i].index = i;
+            population->individuals[i].genome = population->genomes + i * population->row;
+            population->individuals[i].size = population->stride;
+            population->individuals[i].width = width;
+        }
+    }
+    return population;
+}
+
+/**
+ * Exchanges the front and back genome matrices (and hashes) of a population and rebinds its individuals to the
+ * new front.
+ * @param population the population.
+ */
+static void _population_swap(Population *population) {
+    unsigned char *genomes = population->back;
+    uint64_t *hashes = population->back_hashes;
+    population->back = population->genomes;
+    population->genomes = genomes;
+    population->back_hashes = population->hashes;
+    population->hashes = hashes;
+    for (unsigned int i = 0; i < population->size; i++) {
+        population->individuals[i].genome = genomes + i * population->row;
+    }
+}
+
+/**
+ * Records an individual as the best one found so far by a solver. The storage is reused between calls.
+ * @param solver the solver.
+ * @param individual the individual.
+ */
+static void _keep_best(Solver *solver, const Individual *individual) {
+    Individual *best = solver->best;
+    if (best && best->size == individual->size && best->width == individual->width) {
+        best->index = individual->index;
+        memcpy(best->genome, individual->genome, (size_t)individual->size * individual->width);
+    } else {
+        if (best) {
+            ga_individual_destroy(best);
+        }
+        solver->best = ga_individual_clone(individual);
+    }
+}
+
+/**
+ * Creates a population of individuals.
+ * @param solver the solver drawing the random genomes.
+ * @param generator the generator.
+ * @param size the size of the population (must be even).
+ * @return the population or NULL.
+ */
+Population* ga_population_create(Solver *solver, const GeneticGenerator* generator, unsigned int size){
+    Population *population = NULL;
+    if (size && (size % 2 == 0)){
+        population = _population_alloc(generator, size);
+        if (population) {
+            for(unsigned int i = 0; i < size; i++){
+                _generator_fill(population->genetic_generator, population->width, population->individuals[i].genome,
+                                &solver->random);
+            }
+        }
+    }
+    return population;
+}
+/**
+ * Frees the memory taken by a population.
+ * @param population the population to destroy.
+ */
+void ga_population_destroy(Population* population){
+    ga_free(population->picks);
+    ga_free(population->notes);
+    ga_free(population->keys);
+    ga_free(population->lineages);
+    ga_free(population->changes);
+    ga_free(population->hashes);
+    ga_free(population->back_hashes);
+    genetic_generator_destroy(population->genetic_generator);
+    ga_free(population);
+}
+
+/**
+ * Converts a probability into a threshold for random 32 bits words.
+ * @param probability the probability.
+ * @return the threshold under which a word occurs with the probability.
+ */
+static uint64_t _threshold(float probability) {
+    if (probability <= 0) {
+        return 0;
+    } else if (probability >= 1) {
+        return 1ULL << 32;
+    } else {
+        return (uint64_t)((double)probability * 4294967296.0);
+    }
+}
+
+/**
+ * Prepares the change lists of a population for the incremental evaluation of its next children.
+ * They are allocated once, on the first generation bred with incremental evaluation.
+ * @param population the population.
+ * @param limit the maximum number of changed chromosomes worth an incremental evaluation.
+ * @return whether the lists are available.
+ */
+static bool _population_lineages(Population *population, unsigned int limit) {
+    limit = MIN(limit, population->stride);
+    if (population->lineages && population->delta_limit != limit) {
+        ga_free(population->lineages);
+        ga_free(population->changes);
+        population->lineages = NULL;
+        population->changes = NULL;
+    }
+    if (!population->lineages) {
+        population->lineages = ga_malloc(population->size * sizeof(Lineage));
+        population->changes = ga_malloc((size_t)population->size * (limit + 1) * sizeof(unsigned int));
+        if (!population->lineages || !population->changes) {
+            ga_free(population->lineages);
+            ga_free(population->changes);
+            population->lineages = NULL;
+            population->changes = NULL;
+            return false;
+        }
+        population->delta_limit = limit;
+    }
+    return true;
+}
+
+/**
+ * Records how a child differs from the parent it was copied from, for its incremental evaluation.
+ * @param population the population.
+ * @param index the row of the child in the back genome matrix.
+ * @param parent the parent.
+ * @param note the rating of the parent.
+ */
+static void _record_lineage(Population *population, unsigned int index, const Individual *parent, unsigned int note) {
+    const unsigned char *child = population->back + index * population->row;
+    unsigned int *changes = population->changes + (size_t)index * (population->delta_limit + 1);
+    Lineage *lineage = &population->lineages[index];
+    unsigned int width = population->width;
+    unsigned int count = 0;
+    for (unsigned int y = 0; y < population->stride; y++) {
+        changes[count] = y;
+        count += ga_genome_get(child, width, y) != ga_genome_get(parent->genome, width, y);
+        if (count > population->delta_limit) {
+            lineage->parent = GA_NO_PARENT;
+            return;
+        }
+    }
+    lineage->parent = parent->index;
+    lineage->note = note;
+    lineage->count = count;
+}
+
+/**
+ * Prepares the genome hashes of a population for its fitness cache. They are allocated once, on the first
+ * generation evaluated with a cache.
+ * @param population the population.
+ * @return whether the hashes are available.
+ */
+static bool _population_hashes(Population *population) {
+    if (!population->hashes) {
+        population->hashes = ga_malloc(population->size * sizeof(uint64_t));
+        population->back_hashes = ga_malloc(population->size * sizeof(uint64_t));
+        if (!population->hashes || !population->back_hashes) {
+            ga_free(population->hashes);
+            ga_free(population->back_hashes);
+            population->hashes = NULL;
+            population->back_hashes = NULL;
+            return false;
+        }
+        population->hashes_valid = false;
+    }
+    return true;
+}
+
+/**
+ * Gets the Zobrist key of a value at a position of a genome. Keys are mixed from the position and the value
+ * rather than drawn into a table, so any cardinality is covered.
+ * @param index the position.
+ * @param value the value.
+ * @return the key.
+ */
+static inline uint64_t _zobrist(unsigned int index, unsigned int value) {
+    uint64_t key = ((uint64_t)index << 32 | value) + 0x9E3779B97F4A7C15ULL;
+    key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+    return key ^ (key >> 31);
+}
+
+/**
+ * Hashes a genome: the exclusive or of the Zobrist keys of its chromosomes.
+ * @param genome the genome.
+ * @param size the number of chromosomes.
+ * @param width the number of bytes of a chromosome.
+ * @return the hash.
+ */
+static uint64_t _genome_hash(const void *genome, unsigned int size, unsigned int width) {
+    uint64_t hash = 0;
+    for (unsigned int y = 0; y < size; y++) {
+        hash ^= _zobrist(y, ga_genome_get(genome, width, y));
+    }
+    return hash;
+}
+
+/**
+ * Hashes a child from the hash of the parent it was copied from, updating only the chromosomes that changed.
+ * The genomes are compared eight bytes at a time, a width always dividing eight.
+ * @param hash the hash of the parent.
+ * @param child the child.
+ * @param parent the parent.
+ * @param size the number of chromosomes.
+ * @param width the number of bytes of a chromosome.
+ * @return the hash of the child.
+ */
+static uint64_t _genome_rehash(uint64_t hash, const void *child, const void *parent, unsigned int size,
+                               unsigned int width) {
+    const unsigned char *first = child;
+    const unsigned char *second = parent;
+    size_t row = (size_t)size * width;
+    for (size_t byte = 0; byte < row; byte += 8) {
+        size_t length = MIN(8, row - byte);
+        uint64_t a = 0;
+        uint64_t b = 0;
+        memcpy(&a, first + byte, length);
+        memcpy(&b, second + byte, length);
+        if (a == b) {
+            continue;
+        }
+        for (unsigned int y = (unsigned int)(byte / width); y < (byte + length) / width; y++) {
+            unsigned int old_value = ga_genome_get(parent, width, y);
+            unsigned int new_value = ga_genome_get(child, width, y);
+            if (old_value != new_value) {
+                hash ^= _zobrist(y, old_value) ^ _zobrist(y, new_value);
+            }
+        }
+    }
+    return hash;
+}
+
+/**
+ * The evaluation job of a generation.
+ */
+typedef struct {
+    const Solver *solver;
+    Population *population;
+    EvaluateFunction evaluate;
+    const void *problem;
+    atomic_uint hits;
+    _Allocations *allocations;
+} _Evaluation;
+
+/**
+ * Evaluates a chunk of the individuals of a population into its ranks. The children found in the fitness cache
+ * of the solver get their rating back without being evaluated.
+ * @param arg the evaluation job.
+ * @param begin the first individual.
+ * @param end the individual following the last one.
+ */
+static void _evaluate_task(void *arg, unsigned int begin, unsigned int end) {
+    _Evaluation *evaluation = arg;
+    const Solver *solver = evaluation->solver;
+    Population *population = evaluation->population;
+    _Allocations *allocations = _allocations_attach(evaluation->allocations);
+    bool incremental = solver->evaluate_delta && population->lineages_valid;
+    const FitnessCache *cache = population->hashes ? solver->cache : NULL;
+    const void *batch[GA_BATCH_SIZE];
+    unsigned int indices[GA_BATCH_SIZE];
+    unsigned int notes[GA_BATCH_SIZE];
+    unsigned int count = 0;
+    unsigned int hits = 0;
+    for (unsigned int i = begin; i < end; i++) {
+        population->ranks[i].individual = &population->individuals[i];
+        if (cache && !population->hashes_valid) {
+            population->hashes[i] = _genome_hash(population->individuals[i].genome, population->stride,
+                                                 population->width);
+        }
+        if (i < population->survivors) {
+            population->ranks[i].note = population->notes[i];
+        } else if (cache && _cache_lookup(cache, population->hashes[i], &population->ranks[i].note)) {
+            hits++;
+        } else if (incremental && population->lineages[i].parent != GA_NO_PARENT) {
+            const Lineage *lineage = &population->lineages[i];
+            population->ranks[i].note = solver->evaluate_delta(
+                population->back + lineage->parent * population->row, lineage->note,
+                population->individuals[i].genome, population->changes + (size_t)i * (population->delta_limit + 1),
+                lineage->count, evaluation->problem);
+        } else if (solver->evaluate_batch) {
+            batch[count] = population->individuals[i].genome;
+            indices[count++] = i;
+            if (count == GA_BATCH_SIZE) {
+                solver->evaluate_batch(batch, count, notes, evaluation->problem);
+                for (unsigned int j = 0; j < count; j++) {
+                    population->ranks[indices[j]].note = notes[j];
+                }
+                count = 0;
+            }
+        } else {
+            population->ranks[i].note = evaluation->evaluate(population->individuals[i].genome, evaluation->problem);
+        }
+    }
+    if (count) {
+        solver->evaluate_batch(batch, count, notes, evaluation->problem);
+        for (unsigned int j = 0; j < count; j++) {
+            population->ranks[indices[j]].note = notes[j];
+        }
+    }
+    if (hits) {
+        atomic_fetch_add_explicit(&evaluation->hits, hits, memory_order_relaxed);
+    }
+    _allocations_attach(allocations);
+}
+
+/**
+ * The local search job of a generation.
+ */
+typedef struct {
+    const Solver *solver;
+    Population *population;
+    const void *problem;
+    unsigned long long seed;
+    _Allocations *allocations;
+} _LocalSearch;
+
+/**
+ * Improves a chunk of the picked individuals of a population. The random stream of an individual is its index,
+ * so the outcome does not depend on the threads.
+ * @param arg the local search job.
+ * @param begin the first pick.
+ * @param end the pick following the last one.
+ */
+static void _local_search_task(void *arg, unsigned int begin, unsigned int end) {
+    _LocalSearch *job = arg;
+    Population *population = job->population;
+    _Allocations *allocations = _allocations_attach(job->allocations);
+    for (unsigned int j = begin; j < end; j++) {
+        unsigned int i = population->picks[j];
+        Random random;
+        ga_random_seed(&random, job->seed, i);
+        population->ranks[i].note = job->solver->local_search(population->individuals[i].genome,
+                                                              population->ranks[i].note, job->problem, &random);
+        if (population->hashes_valid) {
+            population->hashes[i] = _genome_hash(population->individuals[i].genome, population->stride,
+                                                 population->width);
+        }
+    }
+    _allocations_attach(allocations);
+}
+
+/**
+ * Moves the indices of the count best rated individuals to the front of a list of indices, by a quickselect.
+ * @param ranks the ratings of the individuals.
+ * @param picks the indices.
+ * @param size the number of indices.
+ * @param count the number of best individuals.
+ */
+static void _select_best(const Fortune_Rank *ranks, unsigned int *picks, unsigned int size, unsigned int count) {
+    unsigned int low = 0;
+    unsigned int high = size;
+    while (high - low > 1 && count > low && count < high) {
+        unsigned int pivot = ranks[picks[low + (high - low) / 2]].note;
+        unsigned int less = low;
+        unsigned int greater = high;
+        /* three-way partition: [low, less) < pivot, [less, greater) == pivot, [greater, high) > pivot */
+        for (unsigned int i = low; i < greater;) {
+            unsigned int note = ranks[picks[i]].note;
+            unsigned int pick = picks[i];
+            if (note < pivot) {
+                picks[i++] = picks[less];
+                picks[less++] = pick;
+            } else if (note > pivot) {
+                picks[i] = picks[--greater];
+                picks[greater] = pick;
+            } else {
+                i++;
+            }
+        }
+        if (count < less) {
+            high = less;
+        } else if (count > greater) {
+            low = greater;
+        } else {
+            break;
+        }
+    }
+}
+
+/**
+ * Prepares the list of indices of a population, allocated on its first use, and fills it with the identity.
+ * @param population the population.
+ * @return whether the list is available.
+ */
+static bool _population_picks(Population *population) {
+    if (!population->picks) {
+        population->picks = ga_malloc(sizeof(unsigned int) * population->size);
+        if (!population->picks) {
+            return false;
+        }
+    }
+    for (unsigned int i = 0; i < population->size; i++) {
+        population->picks[i] = i;
+    }
+    return true;
+}
+
+/**
+ * Gets the number of individuals of a generation surviving unchanged into the next one: the elites, or the
+ * individuals not replaced in a steady state, rounded up to an even number since children are bred by pairs.
+ * At least two children are bred. The survivors are copied with their ratings into the first rows of the back
+ * genome matrix.
+ * @param solver the solver.
+ * @param population the population.
+ * @return the number of survivors.
+ */
+static unsigned int _population_survive(const Solver *solver, Population *population) {
+    unsigned int replaced = (unsigned int)(solver->replacement * population->size + 0.5f);
+    unsigned int survivors = MAX(solver->elites, population->size - MIN(replaced, population->size));
+    survivors = MIN(survivors + survivors % 2, population->size - 2);
+    if (!survivors) {
+        return 0;
+    }
+    if (!population->notes) {
+        population->notes = ga_malloc(sizeof(unsigned int) * population->size);
+    }
+    if (!population->notes || !_population_picks(population)) {
+        return 0;
+    }
+    _select_best(population->ranks, population->picks, population->size, survivors);
+    for (unsigned int i = 0; i < survivors; i++) {
+        unsigned int pick = population->picks[i];
+        memcpy(population->back + i * population->row, population->individuals[pick].genome, population->row);
+        population->notes[i] = population->ranks[pick].note;
+        if (population->hashes_valid) {
+            population->back_hashes[i] = population->hashes[pick];
+        }
+    }
+    return survivors;
+}
+
+/**
+ * The selection of the parents of a generation.
+ */
+typedef struct {
+    SelectionStrategy strategy;
+    unsigned int size;
+    float pressure;
+} _Selection;
+
+/**
+ * Compares two sort keys.
+ * @param first the first key.
+ * @param second the second key.
+ * @return a negative, null or positive number as the first key is lower, equal or greater.
+ */
+static int _key_compare(const void *first, const void *second) {
+    unsigned long long a = *(const unsigned long long *)first;
+    unsigned long long b = *(const unsigned long long *)second;
+    return (a > b) - (a < b);
+}
+
+/**
+ * Prepares the selection of the parents of a rated generation: builds the fortune wheel of a roulette, sorts the
+ * indices of the individuals by rating for a linear ranking or moves the best ones to the front for a truncation.
+ * A strategy lacking memory falls back to the roulette.
+ * @param solver the solver.
+ * @param population the population.
+ * @param sum_of_fitness the sum of the ratings.
+ * @return the selection.
+ */
+static _Selection _selection_prepare(const Solver *solver, Population *population, unsigned long long sum_of_fitness) {
+    _Selection selection = {solver->selection, population->size, solver->selection_parameter};
+    if (selection.strategy == GA_SELECTION_TOURNAMENT) {
+        selection.size = (unsigned int)(solver->selection_parameter + 0.5f);
+        return selection;
+    }
+    if (selection.strategy == GA_SELECTION_RANK) {
+        if (!population->keys) {
+            population->keys = ga_malloc(sizeof(unsigned long long) * population->size);
+        }
+        if (population->keys && _population_picks(population)) {
+            /* the index breaks the ties, so the order does not depend on the sort */
+            for (unsigned int i = 0; i < population->size; i++) {
+                population->keys[i] = (unsigned long long)population->ranks[i].note << 32 | i;
+            }
+            qsort(population->keys, population->size, sizeof(unsigned long long), _key_compare);
+            for (unsigned int i = 0; i < population->size; i++) {
+                population->picks[i] = (unsigned int)population->keys[i];
+            }
+            return selection;
+        }
+    }
+    if (selection.strategy == GA_SELECTION_TRUNCATION && _population_picks(population)) {
+        selection.size = MAX((unsigned int)(solver->selection_parameter * population->size + 0.5f), 1);
+        _select_best(population->ranks, population->picks, population->size, selection.size);
+        return selection;
+    }
+    selection.strategy = GA_SELECTION_ROULETTE;
+    ga_fortune_wheel_build(population->ranks, population->size, sum_of_fitness);
+    return selection;
+}
+
+/**
+ * Selects a parent in a rated generation.
+ * @param selection the selection prepared by _selection_prepare.
+ * @param population the population.
+ * @param random the random generator.
+ * @return the parent.
+ */
+static Individual *_select(const _Selection *selection, const Population *population, Random *random) {
+    const Fortune_Rank *ranks = population->ranks;
+    switch (selection->strategy) {
+        case GA_SELECTION_TOURNAMENT: {
+            unsigned int best = ga_random_number(random, population->size);
+            for (unsigned int i = 1; i < selection->size; i++) {
+                unsigned int other = ga_random_number(random, population->size);
+                if (ranks[other].note < ranks[best].note) {
+                    best = other;
+                }
+            }
+            return ranks[best].individual;
+        }
+        case GA_SELECTION_RANK: {
+            /* the better of two uniform ranks with probability pressure - 1 follows the linear ranking */
+            unsigned int rank = ga_random_number(random, population->size);
+            if (ga_random_unit(random) < selection->pressure - 1) {
+                rank = MIN(rank, ga_random_number(random, population->size));
+            }
+            return ranks[population->picks[rank]].individual;
+        }
+        case GA_SELECTION_TRUNCATION:
+            return ranks[population->picks[ga_random_number(random, selection->size)]].individual;
+        default:
+            return get_random_individual(random, ranks, population->size);
+    }
+}
+
+/**
+ * Improves the best or random individuals of a rated generation with the local search of a solver.
+ * @param solver the solver.
+ * @param population the population.
+ * @param problem the problem given to the local search.
+ */
+static void _local_search(Solver *solver, Population *population, const void *problem) {
+    unsigned int count = (unsigned int)(solver->local_fraction * population->size + 0.5f);
+    _LocalSearch job = {solver, population, problem, ga_random_next(&solver->random), _allocations_current()};
+    double start;
+    if (!count) {
+        count = 1;
+    }
+    count = MIN(count, population->size);
+    if (!_population_picks(population)) {
+        return;
+    }
+    start = _now();
+    if (solver->local_selection == GA_LOCAL_SEARCH_BEST) {
+        _select_best(population->ranks, population->picks, population->size, count);
+    } else {
+        /* partial Fisher-Yates shuffle */
+        for (unsigned int i = 0; i < count; i++) {
+            unsigned int j = i + ga_random_number(&solver->random, population->size - i);
+            unsigned int pick = population->picks[i];
+            population->picks[i] = population->picks[j];
+            population->picks[j] = pick;
+        }
+    }
+    _thread_pool_run(solver->thread_pool, _local_search_task, &job, count);
+    solver->local_time += _now() - start;
+}
+
+/**
+ * Mutates a chromosome of a permutation segment by swapping it with another one of the segment. The other
+ * chromosome is the first one from a random position whose value and the mutated one both stay in their domains.
+ * @param generator the generator.
+ * @param width the number of bytes of a chromosome.
+ * @param genome the genome.
+ * @param begin the position of the first chromosome of the segment.
+ * @param length the length of the segment.
+ * @param index the position of the mutated chromosome.
+ * @param random the random generator.
+ */
+static void _segment_mutate(const GeneticGenerator *generator, unsigned int width, void *genome, unsigned int begin,
+                            unsigned int length, unsigned int index, Random *random) {
+    unsigned int start = ga_random_number(random, length);
+    unsigned int value;
+    if (!generator->domain_offsets) {
+        _genome_swap(genome, width, index, begin + start);
+        return;
+    }
+    value = ga_genome_get(genome, width, index);
+    for (unsigned int i = 0; i < length; i++) {
+        unsigned int other = begin + (start + i) % length;
+        if (other != index && _domain_contains(generator, other, value) &&
+            _domain_contains(generator, index, ga_genome_get(genome, width, other))) {
+            _genome_swap(genome, width, index, other);
+            return;
+        }
+    }
+}
+
+/**
+ * Gets the number of chromosomes of the unit of variation starting at a chromosome: a whole permutation segment or
+ * a single chromosome.
+ * @param generator the generator.
+ * @param index the position of the chromosome.
+ * @return the length of the unit.
+ */
+static inline unsigned int _unit_length(const GeneticGenerator *generator, unsigned int index) {
+    return generator->segments && generator->segments[index] ? generator->segments[index] : 1;
+}
+
+/**
+ * Gets the position of the first chromosome of a unit of variation.
+ * @param generator the generator.
+ * @param unit the number of the unit (the number of units to get the size of the generator).
+ * @return the position.
+ */
+static unsigned int _unit_position(const GeneticGenerator *generator, unsigned int unit) {
+    unsigned int index = 0;
+    if (!generator->segments) {
+        return MIN(unit, generator->size);
+    }
+    while (unit-- && index < generator->size) {
+        index += _unit_length(generator, index);
+    }
+    return index;
+}
+
+/**
+ * Counts the units of variation of a generator.
+ * @param generator the generator.
+ * @return the number of units.
+ */
+static unsigned int _unit_count(const GeneticGenerator *generator) {
+    unsigned int count = 0;
+    if (!generator->segments) {
+        return generator->size;
+    }
+    for (unsigned int index = 0; index < generator->size; index += _unit_length(generator, index)) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Tells whether a chromosome belongs to a permutation segment.
+ * @param generator the generator.
+ * @param index the position of the chromosome.
+ * @return whether the chromosome belongs to a segment.
+ */
+static bool _unit_in_segment(const GeneticGenerator *generator, unsigned int index) {
+    unsigned int begin = 0;
+    if (!generator->segments) {
+        return false;
+    }
+    while (begin + _unit_length(generator, begin) <= index) {
+        begin += _unit_length(generator, begin);
+    }
+    return generator->segments[begin] != 0;
+}
+
+/**
+ * Tells whether a chromosome may take a value: the value belongs to its domain and does not exceed its
+ * cardinality.
+ * @param generator the generator.
+ * @param index the position of the chromosome.
+ * @param value the value.
+ * @return whether the chromosome may take the value.
+ */
+static inline bool _generator_accepts(const GeneticGenerator *generator, unsigned int index, unsigned int value) {
+    return value >= 1 && value <= MAX(generator->cardinalities[index], 1) && _domain_contains(generator, index, value);
+}
+
+/**
+ * Exchanges a range of chromosomes between two genomes.
+ * @param sister the first genome.
+ * @param brother the second genome.
+ * @param width the number of bytes of a chromosome.
+ * @param begin the position of the first chromosome.
+ * @param end the position following the last chromosome.
+ */
+static void _genomes_exchange(void *sister, void *brother, unsigned int width, unsigned int begin, unsigned int end) {
+    unsigned char *first = (unsigned char *)sister + (size_t)begin * width;
+    unsigned char *second = (unsigned char *)brother + (size_t)begin * width;
+    for (size_t i = 0; i < (size_t)(end - begin) * width; i++) {
+        unsigned char byte = first[i];
+        first[i] = second[i];
+        second[i] = byte;
+    }
+}
+
+/**
+ * Exchanges the units of variation of two children, each one with a probability. The exchanged units are drawn
+ * by geometric skips rather than by a random number per unit.
+ * @param generator the generator.
+ * @param width the number of bytes of a chromosome.
+ * @param sister the first child, a copy of the first parent.
+ * @param brother the second child, a copy of the second parent.
+ * @param rate the probability to exchange a unit.
+ * @param random the random generator.
+ * @param problem the problem of the run (unused).
+ */
+void ga_cross_over_uniform(const GeneticGenerator *generator, unsigned int width, void *sister, void *brother,
+                           float rate, Random *random, const void *problem) {
+    (void)problem;
+    unsigned int skip = ga_random_geometric(random, rate);
+    if (!generator->segments) {
+        for (size_t y = skip; y < generator->size; y += (size_t)1 + ga_random_geometric(random, rate)) {
+            _genomes_exchange(sister, brother, width, (unsigned int)y, (unsigned int)y + 1);
+        }
+        return;
+    }
+    for (unsigned int y = 0, length; y < generator->size && skip != UINT_MAX; y += length) {
+        length = _unit_length(generator, y);
+        if (skip) {
+            skip--;
+        } else {
+            _genomes_exchange(sister, brother, width, y, y + length);
+            skip = ga_random_geometric(random, rate);
+        }
+    }
+}
+
+/**
+ * Exchanges, with a probability, the units of variation of two children following a random cut.
+ * @param generator the generator.
+ * @param width the number of bytes of a chromosome.
+ * @param sister the first child, a copy of the first parent.
+ * @param brother the second child, a copy of the second parent.
+ * @param rate the probability to cross the children over.
+ * @param random the random generator.
+ * @param problem the problem of the run (unused).
+ */
+void ga_cross_over_one_point(const GeneticGenerator *generator, unsigned int width, void *sister, void *brother,
+                             float rate, Random *random, const void *problem) {
+    (void)problem;
+    unsigned int units = _unit_count(generator);
+    if (units < 2 || ga_random_unit(random) >= rate) {
+        return;
+    }
+    _genomes_exchange(sister, brother, width, _unit_position(generator, 1 + ga_random_number(random, units - 1)),
+                      generator->size);
+}
+
+/**
+ * Exchanges, with a probability, the units of variation of two children lying between two random cuts.
+ * @param generator the generator.
+ * @param width the number of bytes of a chromosome.
+ * @param sister the first child, a copy of the first parent.
+ * @param brother the second child, a copy of the second parent.
+ * @param rate the probability to cross the children over.
+ * @param random the random generator.
+ * @param problem the problem of the run (unused).
+ */
+void ga_cross_over_two_point(const GeneticGenerator *generator, unsigned int width, void *sister, void *brother,
+                             float rate, Random *random, const void *problem) {
+    (void)problem;
+    unsigned int units = _unit_count(generator);
+    unsigned int first;
+    unsigned int second;
+    if (units < 2 || ga_random_unit(random) >= rate) {
+        return;
+    }
+    /* two distinct cuts among the units + 1 boundaries */
+    first = ga_random_number(random, units + 1);
+    second = ga_random_number(random, units);
+    second += second >= first;
+    _genomes_exchange(sister, brother, width, _unit_position(generator, MIN(first, second)),
+                      _unit_position(generator, MAX(first, second)));
+}
+
+/**
+ * Exchanges the permutation segments of two children, each one with a probability. The chromosomes outside
+ * the segments are kept.
+ * @param generator the generator.
+ * @param width the number of bytes of a chromosome.
+ * @param sister the first child, a copy of the first parent.
+ * @param brother the second child, a copy of the second parent.
+ * @param rate the probability to exchange a segment.
+ * @param random the random generator.
+ * @param problem the problem of the run (unused).
+ */
+void ga_cross_over_segment(const GeneticGenerator *generator, unsigned int width, void *sister, void *brother,
+                           float rate, Random *random, const void *problem) {
+    (void)problem;
+    unsigned int skip;
+    if (!generator->segments) {
+        return;
+    }
+    skip = ga_random_geometric(random, rate);
+    for (unsigned int y = 0, length; y < generator->size && skip != UINT_MAX; y += length) {
+        length = _unit_length(generator, y);
+        if (!generator->segments[y]) {
+            continue;
+        }
+        if (skip) {
+            skip--;
+        } else {
+            _genomes_exchange(sister, brother, width, y, y + length);
+            skip = ga_random_geometric(random, rate);
+        }
+    }
+}
+
+/**
+ * The mutation of a chromosome by a mutation operator.
+ * @param generator the generator.
+ * @param width the number of bytes of a chromosome.
+ * @param genome the genome.
+ * @param begin the position of the first chromosome of the unit of variation holding the mutated one.
+ * @param length the length of the unit (a permutation segment if the generator has one at begin).
+ * @param index the position of the mutated chromosome.
+ * @param random the random generator.
+ */
+typedef void (*_LocusMutation)(const GeneticGenerator *generator, unsigned int width, void *genome,
+                               unsigned int begin, unsigned int length, unsigned int index, Random *random);
+
+/**
+ * Mutates the chromosomes of a genome, each one with a probability. The mutated chromosomes are drawn by
+ * geometric skips rather than by a random number per chromosome.
+ * @param generator the generator.
+ * @param width the number of bytes of a chromosome.
+ * @param genome the genome.
+ * @param rate the probability to mutate a chromosome.
+ * @param random the random generator.
+ * @param mutate the mutation of a chromosome.
+ */
+static void _mutate(const GeneticGenerator *generator, unsigned int width, void *genome, float rate, Random *random,
+                    _LocusMutation mutate) {
+    unsigned int begin = 0;
+    unsigned int length = generator->size ? _unit_length(generator, 0) : 0;
+    for (size_t y = ga_random_geometric(random, rate); y < generator->size;
+         y += (size_t)1 + ga_random_geometric(random, rate)) {
+        while (begin + length <= y) {
+            begin += length;
+            length = _unit_length(generator, begin);
+        }
+        mutate(generator, width, genome, begin, length, (unsigned int)y, random);
+    }
+}
+
+/**
+ * Draws a new value for a chromosome, or swaps it within its permutation segment.
+ */
+static void _mutate_reset(const GeneticGenerator *generator, unsigned int width, void *genome, unsigned int begin,
+                          unsigned int length, unsigned int index, Random *random) {
+    if (generator->segments && generator->segments[begin]) {
+        _segment_mutate(generator, width, genome, begin, length, index, random);
+    } else {
+        ga_genome_set(genome, width, index, _generator_draw(generator, index, random));
+    }
+}
+
+/**
+ * Swaps a chromosome within its permutation segment, or with a random chromosome outside the segments if both
+ * values are allowed at their new positions.
+ */
+static void _mutate_swap(const GeneticGenerator *generator, unsigned int width, void *genome, unsigned int begin,
+                         unsigned int length, unsigned int index, Random *random) {
+    unsigned int other;
+    if (generator->segments && generator->segments[begin]) {
+        _segment_mutate(generator, width, genome, begin, length, index, random);
+        return;
+    }
+    other = ga_random_number(random, generator->size);
+    if (other != index && !_unit_in_segment(generator, other) &&
+        _generator_accepts(generator, other, ga_genome_get(genome, width, index)) &&
+        _generator_accepts(generator, index, ga_genome_get(genome, width, other))) {
+        _genome_swap(genome, width, index, other);
+    }
+}
+
+/**
+ * Moves a chromosome to a neighbouring value of its domain or of its cardinality, or swaps it with a neighbouring
+ * chromosome of its permutation segment if both values stay in their domains.
+ */
+static void _mutate_creep(const GeneticGenerator *generator, unsigned int width, void *genome, unsigned int begin,
+                          unsigned int length, unsigned int index, Random *random) {
+    bool up = ga_random_next(random) >> 63;
+    unsigned int value = ga_genome_get(genome, width, index);
+    if (generator->segments && generator->segments[begin]) {
+        unsigned int other = up ? index + 1 : index - 1;
+        if (length > 1 && (up ? index + 1 < begin + length : index > begin) &&
+            _domain_contains(generator, other, value) &&
+            _domain_contains(generator, index, ga_genome_get(genome, width, other))) {
+            _genome_swap(genome, width, index, other);
+        }
+        return;
+    }
+    if (generator->domain_offsets && generator->domain_offsets[index + 1] > generator->domain_offsets[index]) {
+        const unsigned int *values = generator->domain_values + generator->domain_offsets[index];
+        unsigned int count = generator->domain_offsets[index + 1] - generator->domain_offsets[index];
+        unsigned int position = 0;
+        while (position < count && values[position] != value) {
+            position++;
+        }
+        if (position == count) {
+            position = ga_random_number(random, count);
+        } else if (up) {
+            position = MIN(position + 1, count - 1);
+        } else if (position) {
+            position--;
+        }
+        ga_genome_set(genome, width, index, values[position]);
+    } else if (up) {
+        ga_genome_set(genome, width, index, MIN(value + 1, MAX(generator->cardinalities[index], 1)));
+    } else {
+        ga_genome_set(genome, width, index, MAX(value, 2) - 1);
+    }
+}
+
+/**
+ * Mutates a genome by drawing new values for its chromosomes, a chromosome of a permutation segment being
+ * swapped within it instead.
+ * @param generator the generator.
+ * @param width the number of bytes of a chromosome.
+ * @param genome the genome.
+ * @param rate the probability to mutate a chromosome.
+ * @param random the random generator.
+ * @param problem the problem of the run (unused).
+ */
+void ga_mutation_reset(const GeneticGenerator *generator, unsigned int width, void *genome, float rate,
+                       Random *random, const void *problem) {
+    (void)problem;
+    _mutate(generator, width, genome, rate, random, _mutate_reset);
+}
+
+/**
+ * Mutates a genome by swapping chromosomes: within their permutation segment, or with a random chromosome
+ * outside the segments.
+ * @param generator the generator.
+ * @param width the number of bytes of a chromosome.
+ * @param genome the genome.
+ * @param rate the probability to mutate a chromosome.
+ * @param random the random generator.
+ * @param problem the problem of the run (unused).
+ */
+void ga_mutation_swap(const GeneticGenerator *generator, unsigned int width, void *genome, float rate,
+                      Random *random, const void *problem) {
+    (void)problem;
+    _mutate(generator, width, genome, rate, random, _mutate_swap);
+}
+
+/**
+ * Mutates a genome by small steps: a chromosome moves to a neighbouring value, or to a neighbouring position
+ * within its permutation segment.
+ * @param generator the generator.
+ * @param width the number of bytes of a chromosome.
+ * @param genome the genome.
+ * @param rate the probability to mutate a chromosome.
+ * @param random the random generator.
+ * @param problem the problem of the run (unused).
+ */
+void ga_mutation_creep(const GeneticGenerator *generator, unsigned int width, void *genome, float rate,
+                       Random *random, const void *problem) {
+    (void)problem;
+    _mutate(generator, width, genome, rate, random, _mutate_creep);
+}
+
+/**
+ * Generates the next generation of a population. The children are bred into the back genome matrix which
+ * then becomes the front one, so no memory is allocated once the best individual storage exists. The
+ * survivors of an elitist or steady-state solver come first and keep their ratings, and so do the children
+ * found in the fitness cache of the solver. A solver with instrumentation records the statistics of the
+ * generation, and a solver with a progress function reports it every few generations.
+ * @param solver the solver
+ * @param population the population
+ * @param cross_over the cross-over rate
+ * @param mutation the mutation rate
+ * @param evaluate the evaluation function (the lower the better)
+ * @param problem the problem given to the evaluation function
+ * @return the population holding the new generation
+ */
+Population* ga_population_next(Solver *solver, Population* population, const float cross_over,const float mutation,EvaluateFunction evaluate,const void *problem){
+    Fortune_Rank *ranks = population->ranks;
+    unsigned int *rolls = population->rolls;
+    Random *random = &solver->random;
+    unsigned int width = population->width;
+    uint64_t crossover_threshold = _threshold(cross_over);
+    uint64_t mutation_threshold = _threshold(mutation);
+    const GeneticGenerator *generator = population->genetic_generator;
+    const unsigned int *segments = generator->segments;
+    unsigned long long sum_of_fitness = 0;
+    _Evaluation evaluation = {solver, population, evaluate, problem, 0, NULL};
+    bool hashing = solver->cache && _population_hashes(population);
+    bool lineages;
+    unsigned int survivors;
+    _Selection selection;
+    CrossOverFunction cross = solver->cross_over;
+    MutationFunction mutate = solver->mutation;
+    _Clock clock;
+    _Clock *timing = _clock_start(solver, &clock);
+    _Allocations *allocations = _allocations_attach(timing ? &timing->allocations : NULL);
+    evaluation.allocations = _allocations_current();
+    GenerationStatistics statistics = {solver->generation, {0}, 0, 0, 0, 0, UINT_MAX, 0, 0};
+    _thread_pool_run(solver->thread_pool, _evaluate_task, &evaluation, population->size);
+    statistics.evaluations = population->size - population->survivors - evaluation.hits;
+    statistics.cache_hits = evaluation.hits;
+    solver->evaluations += statistics.evaluations;
+    if (hashing){
+        /* the cache is only written between the parallel phases */
+        for(unsigned int i = population->survivors; i < population->size; i++){
+            _cache_insert(solver->cache, population->hashes[i], ranks[i].note);
+        }
+        solver->cache->lookups += population->size - population->survivors;
+        solver->cache->hits += evaluation.hits;
+        population->hashes_valid = true;
+    }
+    _clock_lap(timing, GA_PHASE_EVALUATION);
+    if (solver->local_search){
+        _local_search(solver, population, problem);
+        _clock_lap(timing, GA_PHASE_LOCAL_SEARCH);
+    }
+    for(unsigned int i = 0; i < population->size; i++){
+        sum_of_fitness += ranks[i].note;
+        statistics.best = MIN(statistics.best, ranks[i].note);
+        statistics.worst = MAX(statistics.worst, ranks[i].note);
+        if (ranks[i].note < solver->best_score || !solver->best){
+            solver->best_score = ranks[i].note;
+            _keep_best(solver, ranks[i].individual);
+        }
+    }
+    statistics.mean = (double)sum_of_fitness / population->size;
+    lineages = solver->evaluate_delta && _population_lineages(population, solver->delta_limit);
+    _clock_lap(timing, GA_PHASE_BOOKKEEPING);
+    survivors = _population_survive(solver, population);
+    _clock_lap(timing, GA_PHASE_SURVIVAL);
+    selection = _selection_prepare(solver, population, sum_of_fitness);
+    if (cross || mutate){
+        cross = cross ? cross : ga_cross_over_uniform;
+        mutate = mutate ? mutate : ga_mutation_reset;
+    }
+    for(unsigned int i = survivors; i < population->size; i+=2){
+        Individual *mom = _select(&selection, population, random);
+        Individual *dad;
+        unsigned int attempts = 0;
+        do{
+            dad = _select(&selection, population, random);
+        } while (mom->index == dad->index && ++attempts < population->size);
+        if (mom->index == dad->index){
+            dad = &population->individuals[(mom->index + 1) % population->size];
+        }
+        _clock_lap(timing, GA_PHASE_SELECTION);
+        unsigned char *sister = population->back + i * population->row;
+        unsigned char *brother = sister + population->row;
+        memcpy(sister, mom->genome, population->row);
+        memcpy(brother, dad->genome, population->row);
+        _clock_lap(timing, GA_PHASE_CLONING);
+        if (cross || mutate){
+            cross(generator, width, sister, brother, cross_over, random, problem);
+            _clock_lap(timing, GA_PHASE_CROSS_OVER);
+            mutate(generator, width, sister, mutation, random, problem);
+            mutate(generator, width, brother, mutation, random, problem);
+            _clock_lap(timing, GA_PHASE_MUTATION);
+        } else {
+            ga_random_fill(random, rolls, 3 * (size_t)population->stride);
+            for(unsigned int y = 0; y < population->stride; y++){
+                unsigned int length = segments ? segments[y] : 0;
+                if (length){
+                    /* a permutation segment is exchanged as a whole and mutated by swaps within itself */
+                    if (rolls[3 * y] < crossover_threshold){
+                        memcpy(sister + y * width, (const unsigned char *)dad->genome + y * width,
+                               length * width);
+                        memcpy(brother + y * width, (const unsigned char *)mom->genome + y * width,
+                               length * width);
+                    }
+                    for(unsigned int z = y; z < y + length; z++){
+                        if (rolls[3 * z + 1] < mutation_threshold){
+                            _segment_mutate(generator, width, sister, y, length, z, random);
+                        }
+                        if (rolls[3 * z + 2] < mutation_threshold){
+                            _segment_mutate(generator, width, brother, y, length, z, random);
+                        }
+                    }
+                    y += length - 1;
+                    continue;
+                }
+                if (rolls[3 * y] < crossover_threshold){
+                    unsigned int first_individual_chromosome = ga_genome_get(mom->genome, width, y);
+                    unsigned int second_individual_chromosome = ga_genome_get(dad->genome, width, y);
+                    ga_genome_set(sister, width, y, second_individual_chromosome);
+                    ga_genome_set(brother, width, y, first_individual_chromosome);
+                }
+                if (rolls[3 * y + 1] < mutation_threshold){
+                    ga_genome_set(sister, width, y, _generator_draw(generator, y, random));
+                }
+                if (rolls[3 * y + 2] < mutation_threshold){
+                    ga_genome_set(brother, width, y, _generator_draw(generator, y, random));
+                }
+            }
+            /* the built-in kernel fuses the mutation with the cross-over */
+            _clock_lap(timing, GA_PHASE_CROSS_OVER);
+        }
+        if (lineages){
+            _record_lineage(population, i, mom, ranks[mom->index].note);
+            _record_lineage(population, i + 1, dad, ranks[dad->index].note);
+        }
+        if (hashing){
+            population->back_hashes[i] = _genome_rehash(population->hashes[mom->index], sister, mom->genome,
+                                                        population->stride, width);
+            population->back_hashes[i + 1] = _genome_rehash(population->hashes[dad->index], brother, dad->genome,
+                                                            population->stride, width);
+        }
+        _clock_lap(timing, GA_PHASE_BOOKKEEPING);
+    }
+    population->lineages_valid = lineages;
+    population->hashes_valid = hashing;
+    population->survivors = survivors;
+    _population_swap(population);
+    solver->generation++;
+    if (timing){
+        _clock_lap(timing, GA_PHASE_BOOKKEEPING);
+        _instrumentation_record(solver->instrumentation, timing, &statistics);
+    }
+    _allocations_attach(allocations);
+    if (solver->progress && statistics.generation % solver->progress_interval == 0){
+        Progress progress = {statistics.generation, solver->best_score, solver->evaluations,
+                             timing ? ga_solver_get_statistics(solver, 0) : NULL};
+        solver->progress(&progress, solver->progress_data);
+    }
+    return population;
+}
+
+/**
+ * Builds the biased fortune wheel of a generation: each rank receives the cumulative weight of the
+ * individuals up to and including it (the lower the rating of the individual the bigger its slice).
+ * @param ranks the association of the individuals and their rating.
+ * @param size the size of the wheel
+ * @param sum_of_fitness the sum of every rating of every individual.
+ * @return the total weight of the wheel.
+ */
+double ga_fortune_wheel_build(Fortune_Rank *ranks, unsigned int size, unsigned long long sum_of_fitness){
+    double f_sum = (double)sum_of_fitness;
+    double f_pop = (double)size;
+    double T = 0;
+    for(unsigned int i = 0; i < size; i++){
+        double f_note = (double)ranks[i].note;
+        T += sum_of_fitness ? (1 - (f_note / f_sum)) * f_pop : 1;
+        ranks[i].wheel = T;
+    }
+    return T;
+}
+
+/**
+ * Spins the biased fortune wheel built by ga_fortune_wheel_build and returns the selected individual.
+ * The slice is located by a binary search on the cumulative weights.
+ * @param random the random generator.
+ * @param ranks the fortune wheel.
+ * @param size the size of the wheel
+ * @return the selected individual.
+ */
+Individual *get_random_individual(Random *random, const Fortune_Rank *ranks, unsigned int size){
+    double r_number = ga_random_unit(random) * ranks[size - 1].wheel;
+    unsigned int low = 0;
+    unsigned int high = size - 1;
+    while (low < high) {
+        unsigned int middle = low + (high - low) / 2;
+        if (ranks[middle].wheel >= r_number) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return ranks[low].individual;
+}
+
+/**
+ * clones a population.
+ * @param population the population
+ * @return the cloned population.
+ */
+Population *ga_population_clone(const Population *population){
+    Population *clone = _population_alloc(population->genetic_generator, population->size);
+    if (clone) {
+        memcpy(clone->genomes, population->genomes, population->size * population->row);
+        return clone;
+    } else {
+        return NULL;
+    }
+}
+
+/**
+ * clones a individual.
+ * @param individual the individual to clone
+ * @return the cloned individual.
+ */
+Individual* ga_individual_clone(const Individual *individual){
+    Individual *clone = ga_malloc(sizeof(Individual));
+    if (clone) {
+        clone->genome = ga_malloc((size_t)individual->size * individual->width);
+        if (!clone->genome) {
+            ga_free(clone);
+            return NULL;
+        }
+        clone->index = individual->index;
+        clone->size = individual->size;
+        clone->width = individual->width;
+        memcpy(clone->genome, individual->genome, (size_t)individual->size * individual->width);
+    }
+    return clone;
+}
+
+
+/**
+ * Gets a chromosome of an individual.
+ * @param individual the individual.
+ * @param index the position of the chromosome.
+ * @return the chromosome.
+ */
+unsigned int ga_individual_get(const Individual *individual, unsigned int index) {
+    assert(index < individual->size);
+    return ga_genome_get(individual->genome, individual->width, index);
+}
+
+/**
+ * Sets a chromosome of an individual.
+ * @param individual the individual.
+ * @param index the position of the chromosome.
+ * @param value the chromosome.
+ * @return the individual.
+ */
+Individual *ga_individual_set(Individual *individual, unsigned int index, unsigned int value) {
+    assert(index < individual->size);
+    ga_genome_set(individual->genome, individual->width, index, value);
+    return individual;
+}
+
+/**
+ * Frees the memory taken by an individual obtained from ga_individual_clone.
+ * Individuals of a population are views on its genome matrix and are freed with it.
+ * @param individual the individual to destroy.
+ */
+void ga_individual_destroy(Individual *individual){
+    ga_free(individual->genome);
+    ga_free(individual);
+}
+
+/**
+ * Returns the best score found by a solver.
+ * @param solver the solver.
+ * @return the score.
+ */
+unsigned int get_best_score(const Solver *solver){
+    return solver->best_score;
+}
+
+/**
+ * Returns the best individual found by a solver based on its result
+ * @param solver the solver.
+ * @return the best individual (NULL before the first evaluation).
+ */
+Individual *get_best_individual(const Solver *solver){
+    return solver->best;
+}
+
+/**
+ * The fixed-size header of a checkpoint, in the byte order of the machine that wrote it.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t size;
+    uint32_t stride;
+    uint32_t width;
+    uint32_t generation;
+    uint32_t best_score;
+    uint64_t evaluations;
+    uint64_t metadata_size;
+    uint64_t matrix_offset;
+    uint64_t random[4];
+} _CheckpointHeader;
+
+/**
+ * Updates the checksum of a checkpoint with a block of bytes, eight bytes at a time.
+ * @param checksum the checksum so far.
+ * @param data the block.
+ * @param size the number of bytes of the block.
+ * @return the updated checksum.
+ */
+static uint64_t _checksum(uint64_t checksum, const void *data, size_t size) {
+    const unsigned char *bytes = data;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        memcpy(&word, bytes + i, 8);
+        checksum = (checksum ^ word) * 0x100000001B3ULL;
+        checksum ^= checksum >> 29;
+    }
+    for (; i < size; i++) {
+        checksum = (checksum ^ bytes[i]) * 0x100000001B3ULL;
+    }
+    return checksum;
+}
+
+/**
+ * Writes a block of bytes of a checkpoint and updates its checksum.
+ * @param data the block.
+ * @param size the number of bytes of the block.
+ * @param stream the file.
+ * @param checksum the checksum.
+ * @return whether the block could be written.
+ */
+static bool _checkpoint_write(const void *data, size_t size, FILE *stream, uint64_t *checksum) {
+    *checksum = _checksum(*checksum, data, size);
+    return fwrite(data, 1, size, stream) == size;
+}
+
+/**
+ * Reads a block of bytes of a checkpoint and updates its checksum.
+ * @param data the block.
+ * @param size the number of bytes of the block.
+ * @param stream the file.
+ * @param checksum the checksum.
+ * @return whether the block could be read.
+ */
+static bool _checkpoint_read(void *data, size_t size, FILE *stream, uint64_t *checksum) {
+    if (fread(data, 1, size, stream) != size) {
+        return false;
+    }
+    *checksum = _checksum(*checksum, data, size);
+    return true;
+}
+
+/**
+ * Writes a checkpoint of a run: the state of the solver (generation, best score and individual, evaluations and
+ * random generator) and the population to evaluate next with its generator. The genome matrix is written in one
+ * block starting at a page-aligned offset, so it can be memory-mapped or read at once, and a checksum closes the
+ * file. The settings of the solver (evaluation functions, operators, threads) are not saved.
+ * @param solver the solver.
+ * @param population the population.
+ * @param stream the destination file.
+ * @return the population or NULL if the checkpoint cannot be written.
+ */
+Population *ga_checkpoint_fwrite(const Solver *solver, const Population *population, FILE *stream) {
+    _CheckpointHeader header = {GA_CHECKPOINT_MAGIC, GA_CHECKPOINT_VERSION, sizeof(_CheckpointHeader),
+                                population->size, population->stride, population->width, solver->generation,
+                                solver->best_score, solver->evaluations, 0, 0,
+                                {solver->random.state[0], solver->random.state[1], solver->random.state[2],
+                                 solver->random.state[3]}};
+    static const unsigned char padding[GA_CHECKPOINT_ALIGNMENT] = {0};
+    uint32_t best = solver->best != NULL;
+    uint32_t survivors = population->survivors;
+    uint64_t checksum = GA_CHECKPOINT_MAGIC;
+    char *metadata = NULL;
+    size_t size = 0;
+    FILE *memory = open_memstream(&metadata, &size);
+    bool written;
+    if (!memory) {
+        return NULL;
+    }
+    /* the generator, the best individual and the survivors of the population */
+    written = genetic_generator_fwrite(population->genetic_generator, memory) &&
+              fwrite(&best, sizeof(best), 1, memory) == 1 &&
+              (!best || (fwrite(&solver->best->index, sizeof(unsigned int), 1, memory) == 1 &&
+                         fwrite(solver->best->genome, 1, population->row, memory) == population->row)) &&
+              fwrite(&survivors, sizeof(survivors), 1, memory) == 1 &&
+              (!survivors || fwrite(population->notes, sizeof(unsigned int), survivors, memory) == survivors);
+    if (fclose(memory) || !written) {
+        free(metadata);
+        return NULL;
+    }
+    header.metadata_size = size;
+    header.matrix_offset = (sizeof(header) + size + GA_CHECKPOINT_ALIGNMENT - 1) & ~(uint64_t)(GA_CHECKPOINT_ALIGNMENT - 1);
+    written = _checkpoint_write(&header, sizeof(header), stream, &checksum) &&
+              _checkpoint_write(metadata, size, stream, &checksum) &&
+              _checkpoint_write(padding, header.matrix_offset - sizeof(header) - size, stream, &checksum) &&
+              _checkpoint_write(population->genomes, population->size * population->row, stream, &checksum) &&
+              fwrite(&checksum, sizeof(checksum), 1, stream) == 1;
+    free(metadata);
+    return written ? (Population *)population : NULL;
+}
+
+/**
+ * Reads the metadata and the genome matrix of a checkpoint into a new population.
+ * @param header the header of the checkpoint.
+ * @param generator the storage of the generator of the population.
+ * @param memory the metadata.
+ * @param stream the file, positioned at the genome matrix.
+ * @param checksum the checksum so far.
+ * @param best the storage of the best individual.
+ * @return the population or NULL if the checkpoint is truncated or inconsistent.
+ */
+static Population *_checkpoint_parse(const _CheckpointHeader *header, GeneticGenerator *generator, FILE *memory,
+                                     FILE *stream, uint64_t *checksum, Individual *best) {
+    Population *population;
+    uint32_t flag;
+    uint32_t survivors;
+    uint64_t expected;
+    if (!genetic_generator_fread(generator, memory) || generator->size != header->stride ||
+        genetic_generator_get_width(generator) != header->width || fread(&flag, sizeof(flag), 1, memory) != 1) {
+        return NULL;
+    }
+    population = _population_alloc(generator, header->size);
+    if (!population) {
+        return NULL;
+    }
+    best->genome = flag ? ga_malloc(population->row) : NULL;
+    best->size = population->stride;
+    best->width = population->width;
+    if ((flag && (!best->genome || fread(&best->index, sizeof(unsigned int), 1, memory) != 1 ||
+                  fread(best->genome, 1, population->row, memory) != population->row)) ||
+        fread(&survivors, sizeof(survivors), 1, memory) != 1 || survivors >= header->size ||
+        (survivors && !(population->notes = ga_malloc(sizeof(unsigned int) * population->size))) ||
+        (survivors && fread(population->notes, sizeof(unsigned int), survivors, memory) != survivors) ||
+        !_checkpoint_read(population->genomes, population->size * population->row, stream, checksum) ||
+        fread(&expected, sizeof(expected), 1, stream) != 1 || expected != *checksum) {
+        ga_population_destroy(population);
+        return NULL;
+    }
+    population->survivors = survivors;
+    return population;
+}
+
+/**
+ * Reads a checkpoint written by ga_checkpoint_fwrite: restores the state of the solver and creates the
+ * population, so that the run goes on as if it had not been interrupted. The fitness cache and the statistics
+ * of the solver are emptied, as by ga_solver_reset. The solver is left untouched if the checkpoint is
+ * truncated, corrupted or of another version.
+ * @param solver the solver.
+ * @param stream the file.
+ * @return the population (to destroy) or NULL.
+ */
+Population *ga_checkpoint_fread(Solver *solver, FILE *stream) {
+    _CheckpointHeader header;
+    uint64_t checksum = GA_CHECKPOINT_MAGIC;
+    unsigned char *metadata = NULL;
+    GeneticGenerator *generator = NULL;
+    Population *population = NULL;
+    Individual best = {0, NULL, 0, 0};
+    if (!_checkpoint_read(&header, sizeof(header), stream, &checksum) || header.magic != GA_CHECKPOINT_MAGIC ||
+        header.version != GA_CHECKPOINT_VERSION || header.header_size != sizeof(header) ||
+        !header.size || header.size % 2 || (header.width != 1 && header.width != 2 && header.width != 4) ||
+        header.metadata_size < (5 + (uint64_t)header.stride) * sizeof(unsigned int) + 2 * sizeof(uint32_t) ||
+        header.matrix_offset < sizeof(header) + header.metadata_size ||
+        header.matrix_offset - sizeof(header) - header.metadata_size >= GA_CHECKPOINT_ALIGNMENT) {
+        return NULL;
+    }
+    metadata = ga_malloc(header.matrix_offset - sizeof(header));
+    generator = genetic_generator_create(0);
+    if (metadata && generator &&
+        _checkpoint_read(metadata, header.matrix_offset - sizeof(header), stream, &checksum)) {
+        FILE *memory = fmemopen(metadata, header.metadata_size, "rb");
+        if (memory) {
+            population = _checkpoint_parse(&header, generator, memory, stream, &checksum, &best);
+            fclose(memory);
+        }
+    }
+    if (population) {
+        /* the cache and the statistics of a previous run do not carry over */
+        _solver_clear(solver);
+        solver->generation = header.generation;
+        solver->best_score = header.best_score;
+        solver->evaluations = header.evaluations;
+        memcpy(solver->random.state, header.random, sizeof(header.random));
+        if (best.genome) {
+            _keep_best(solver, &best);
+        }
+    }
+    ga_free(best.genome);
+    ga_free(metadata);
+    if (generator) {
+        genetic_generator_destroy(generator);
+    }
+    return population;
+}
+
+/**
+ * Tells whether a run meets one of its stop criteria. A perfect score is checked first.
+ * @param criteria the stop criteria.
+ * @param generations the number of generations run.
+ * @param best the best score.
+ * @param stall the number of generations run since the best score last improved.
+ * @param elapsed the time elapsed since the start of the run in seconds.
+ * @param evaluations the number of evaluations since the start of the run.
+ * @return the reason to stop or GA_STOP_NONE.
+ */
+static StopReason _stop_reason(const StopCriteria *criteria, unsigned int generations, unsigned int best,
+                               unsigned int stall, double elapsed, unsigned long long evaluations) {
+    if (best <= criteria->target) {
+        return GA_STOP_TARGET;
+    }
+    if (criteria->generations && generations >= criteria->generations) {
+        return GA_STOP_GENERATIONS;
+    }
+    if (criteria->stagnation && stall >= criteria->stagnation) {
+        return GA_STOP_STAGNATION;
+    }
+    if (criteria->time > 0 && elapsed >= criteria->time) {
+        return GA_STOP_TIME;
+    }
+    if (criteria->evaluations && evaluations >= criteria->evaluations) {
+        return GA_STOP_EVALUATIONS;
+    }
+    return GA_STOP_NONE;
+}
+
+/**
+ * Evolves a population until one of the stop criteria is met. The criteria are checked after every generation,
+ * so at least one generation is run.
+ * @param solver the solver.
+ * @param population the population.
+ * @param criteria the stop criteria.
+ * @param cross_over the cross-over rate.
+ * @param mutation the mutation rate.
+ * @param evaluate the evaluation function.
+ * @param problem the problem given to the evaluation function.
+ * @return the reason why the run stopped.
+ */
+StopReason ga_run(Solver *solver, Population *population, const StopCriteria *criteria, const float cross_over,
+                  const float mutation, EvaluateFunction evaluate, const void *problem) {
+    double start = _now();
+    unsigned long long evaluations = solver->evaluations;
+    unsigned int generations = 0;
+    unsigned int stall = 0;
+    StopReason reason = GA_STOP_NONE;
+    while (reason == GA_STOP_NONE) {
+        unsigned int best = solver->best_score;
+        ga_population_next(solver, population, cross_over, mutation, evaluate, problem);
+        generations++;
+        stall = solver->best_score < best ? 0 : stall + 1;
+        reason = _stop_reason(criteria, generations, solver->best_score, stall,
+                              criteria->time > 0 ? _now() - start : 0, solver->evaluations - evaluations);
+    }
+    return reason;
+}
+
+/**
+ * Describes why a run stopped.
+ * @param reason the reason.
+ * @return the description.
+ */
+const char *ga_stop_reason_to_string(StopReason reason) {
+    switch (reason) {
+        case GA_STOP_TARGET:
+            return "target";
+        case GA_STOP_GENERATIONS:
+            return "generations";
+        case GA_STOP_STAGNATION:
+            return "stagnation";
+        case GA_STOP_TIME:
+            return "time";
+        case GA_STOP_EVALUATIONS:
+            return "evaluations";
+        case GA_STOP_ERROR:
+            return "error";
+        default:
+            return "none";
+    }
+}
+
+/**
+ * Creates an archipelago of populations evolving on their own threads and exchanging their best individuals.
+ * Each island has its own solver seeded on its own random stream, so a run only depends on the seed.
+ * @param generator the generator.
+ * @param count the number of islands.
+ * @param size the size of the population of each island (must be even).
+ * @param seed the seed of the random generators of the islands.
+ * @return the archipelago or NULL.
+ */
+Islands *ga_islands_create(const GeneticGenerator *generator, unsigned int count, unsigned int size,
+                           unsigned long long seed) {
+    Islands *islands;
+    if (!count) {
+        return NULL;
+    }
+    islands = ga_malloc(sizeof(Islands));
+    if (islands) {
+        islands->islands = ga_malloc(count * sizeof(Island));
+        if (!islands->islands) {
+            ga_free(islands);
+            return NULL;
+        }
+        islands->count = 0;
+        islands->migrants = 0;
+        islands->outboxes = NULL;
+        islands->picks = NULL;
+        pthread_mutex_init(&islands->mutex, NULL);
+        pthread_cond_init(&islands->barrier, NULL);
+        while (islands->count < count) {
+            Island *island = &islands->islands[islands->count];
+            island->archipelago = islands;
+            island->index = islands->count;
+            island->solver = ga_solver_create(seed);
+            if (island->solver) {
+                ga_random_seed(&island->solver->random, seed, island->index);
+            }
+            island->population = island->solver ? ga_population_create(island->solver, generator, size) : NULL;
+            if (!island->population) {
+                if (island->solver) {
+                    ga_solver_destroy(island->solver);
+                }
+                ga_islands_destroy(islands);
+                return NULL;
+            }
+            islands->count++;
+        }
+        islands->row = islands->islands[0].population->row;
+        islands->topology = GA_TOPOLOGY_RING;
+        if (!ga_islands_set_migration(islands, GA_MIGRATION_INTERVAL, GA_MIGRANTS, GA_TOPOLOGY_RING)) {
+            ga_islands_destroy(islands);
+            return NULL;
+        }
+    }
+    return islands;
+}
+
+/**
+ * Destroys an archipelago, its populations and their solvers.
+ * @param islands the archipelago.
+ */
+void ga_islands_destroy(Islands *islands) {
+    for (unsigned int i = 0; i < islands->count; i++) {
+        ga_population_destroy(islands->islands[i].population);
+        ga_solver_destroy(islands->islands[i].solver);
+    }
+    pthread_cond_destroy(&islands->barrier);
+    pthread_mutex_destroy(&islands->mutex);
+    ga_free(islands->outboxes);
+    ga_free(islands->picks);
+    ga_free(islands->islands);
+    ga_free(islands);
+}
+
+/**
+ * Sets how the islands of an archipelago exchange individuals. Every interval generations, each island
+ * publishes copies of its best individuals and replaces random children by the ones published by another
+ * island: its predecessor on a ring, or an island drawn at random.
+ * @param islands the archipelago.
+ * @param interval the number of generations between migrations (0 to isolate the islands).
+ * @param migrants the number of individuals sent by each island (at most the size of a population).
+ * @param topology the topology.
+ * @return the archipelago or NULL.
+ */
+Islands *ga_islands_set_migration(Islands *islands, unsigned int interval, unsigned int migrants,
+                                  Topology topology) {
+    migrants = MIN(migrants, islands->islands[0].population->size);
+    if (migrants != islands->migrants) {
+        unsigned char *outboxes = NULL;
+        unsigned int *picks = NULL;
+        /* no migrants, no buffers: the islands stay isolated */
+        if (migrants) {
+            outboxes = ga_malloc(2 * (size_t)islands->count * migrants * islands->row);
+            picks = ga_malloc(islands->count * migrants * sizeof(unsigned int));
+        }
+        if (migrants && (!outboxes || !picks)) {
+            ga_free(outboxes);
+            ga_free(picks);
+            return NULL;
+        }
+        ga_free(islands->outboxes);
+        ga_free(islands->picks);
+        islands->outboxes = outboxes;
+        islands->picks = picks;
+        islands->migrants = migrants;
+    }
+    islands->interval = interval;
+    islands->topology = topology;
+    return islands;
+}
+
+/**
+ * Gets the number of islands of an archipelago.
+ * @param islands the archipelago.
+ * @return the number of islands.
+ */
+unsigned int ga_islands_get_count(const Islands *islands) {
+    return islands->count;
+}
+
+/**
+ * Gets the solver of an island, to set how it evaluates its population for instance.
+ * @param islands the archipelago.
+ * @param index the index of the island.
+ * @return the solver.
+ */
+Solver *ga_islands_get_solver(Islands *islands, unsigned int index) {
+    return islands->islands[index].solver;
+}
+
+/**
+ * Gets the population of an island.
+ * @param islands the archipelago.
+ * @param index the index of the island.
+ * @return the population.
+ */
+Population *ga_islands_get_population(Islands *islands, unsigned int index) {
+    return islands->islands[index].population;
+}
+
+/**
+ * Waits until every running island reaches the barrier, or until the run is aborted.
+ * @param islands the archipelago.
+ * @return whether the run goes on.
+ */
+static bool _islands_wait(Islands *islands) {
+    bool running;
+    pthread_mutex_lock(&islands->mutex);
+    if (++islands->waiting == islands->count) {
+        islands->waiting = 0;
+        islands->phase++;
+        pthread_cond_broadcast(&islands->barrier);
+    } else {
+        unsigned long long phase = islands->phase;
+        while (islands->phase == phase && !atomic_load(&islands->abort)) {
+            pthread_cond_wait(&islands->barrier, &islands->mutex);
+        }
+    }
+    running = !atomic_load(&islands->abort);
+    pthread_mutex_unlock(&islands->mutex);
+    return running;
+}
+
+/**
+ * Gets the outbox of an island for a migration. The outboxes are double-buffered: an island fills the
+ * buffer of the current migration while the others may still read the one of the previous migration.
+ * @param islands the archipelago.
+ * @param index the index of the island.
+ * @param migration the number of the migration.
+ * @return the outbox (islands->migrants genomes).
+ */
+static unsigned char *_islands_outbox(const Islands *islands, unsigned int index, unsigned long long migration) {
+    return islands->outboxes + ((migration & 1) * islands->count + index) * islands->migrants * islands->row;
+}
+
+/**
+ * Publishes the best parents of the last generation of an island. They are still in the back genome matrix,
+ * rated by the ranks of the population.
+ * @param island the island.
+ * @param outbox the outbox of the island.
+ */
+static void _island_emigrate(Island *island, unsigned char *outbox) {
+    const Islands *islands = island->archipelago;
+    const Population *population = island->population;
+    unsigned int *picks = islands->picks + island->index * islands->migrants;
+    unsigned int count = 0;
+    for (unsigned int i = 0; i < population->size; i++) {
+        unsigned int note = population->ranks[i].note;
+        unsigned int j = count < islands->migrants ? count++ : islands->migrants;
+        while (j > 0 && population->ranks[picks[j - 1]].note > note) {
+            if (j < islands->migrants) {
+                picks[j] = picks[j - 1];
+            }
+            j--;
+        }
+        if (j < islands->migrants) {
+            picks[j] = i;
+        }
+    }
+    for (unsigned int i = 0; i < islands->migrants; i++) {
+        memcpy(outbox + i * islands->row, population->back + picks[i] * population->row, population->row);
+    }
+}
+
+/**
+ * Replaces random children of an island by the individuals published by another island.
+ * @param island the island.
+ * @param inbox the outbox of the other island.
+ */
+static void _island_immigrate(Island *island, const unsigned char *inbox) {
+    const Islands *islands = island->archipelago;
+    Population *population = island->population;
+    Random *random = &island->solver->random;
+    for (unsigned int i = 0; i < islands->migrants; i++) {
+        unsigned int index = population->survivors + ga_random_number(random, population->size - population->survivors);
+        memcpy(population->genomes + index * population->row, inbox + i * islands->row, population->row);
+        if (population->lineages_valid) {
+            population->lineages[index].parent = GA_NO_PARENT;
+        }
+    }
+    population->hashes_valid = false;
+}
+
+/**
+ * Records the best score of an island in the best score of its archipelago, counting the improvements.
+ * @param islands the archipelago.
+ * @param score the best score of the island.
+ */
+static void _islands_improve(Islands *islands, unsigned int score) {
+    unsigned int best = atomic_load(&islands->best);
+    while (score < best) {
+        if (atomic_compare_exchange_weak(&islands->best, &best, score)) {
+            atomic_fetch_add(&islands->improvements, 1);
+            break;
+        }
+    }
+}
+
+/**
+ * Stops the run of an archipelago, waking the islands waiting for a migration. The first reason is kept.
+ * @param islands the archipelago.
+ * @param reason the reason.
+ */
+static void _islands_stop(Islands *islands, StopReason reason) {
+    pthread_mutex_lock(&islands->mutex);
+    if (!atomic_load(&islands->abort)) {
+        islands->reason = reason;
+        atomic_store(&islands->abort, true);
+    }
+    pthread_cond_broadcast(&islands->barrier);
+    pthread_mutex_unlock(&islands->mutex);
+}
+
+/**
+ * The loop of an island: evolves its population and takes part in the migrations. With stop criteria, the first
+ * island meeting one stops the whole archipelago; the best score, the stagnation, the time and the evaluations
+ * are those of the archipelago.
+ * @param arg the island.
+ * @return NULL.
+ */
+static void *_island_worker(void *arg) {
+    Island *island = arg;
+    Islands *islands = island->archipelago;
+    const StopCriteria *criteria = islands->criteria;
+    Random *random = &island->solver->random;
+    unsigned long long improvements = 0;
+    unsigned long long evaluated = island->solver->evaluations;
+    unsigned int stall = 0;
+    for (unsigned int generation = 1; criteria || generation <= islands->generations; generation++) {
+        if (atomic_load(&islands->abort)) {
+            break;
+        }
+        ga_population_next(island->solver, island->population, islands->cross_over, islands->mutation,
+                           islands->evaluate, islands->problem);
+        if (criteria) {
+            StopReason reason;
+            /* survivors and cache hits are not evaluated, as in ga_run */
+            unsigned long long delta = island->solver->evaluations - evaluated;
+            unsigned long long evaluations = atomic_fetch_add(&islands->evaluations, delta) + delta;
+            evaluated = island->solver->evaluations;
+            _islands_improve(islands, island->solver->best_score);
+            stall = atomic_load(&islands->improvements) == improvements ? stall + 1 : 0;
+            improvements = atomic_load(&islands->improvements);
+            reason = _stop_reason(criteria, generation, atomic_load(&islands->best), stall,
+                                  criteria->time > 0 ? _now() - islands->start : 0, evaluations);
+            if (reason != GA_STOP_NONE) {
+                _islands_stop(islands, reason);
+                break;
+            }
+        }
+        if (islands->interval && islands->count > 1 && islands->migrants && generation % islands->interval == 0) {
+            unsigned long long migration = generation / islands->interval;
+            unsigned int source = islands->topology == GA_TOPOLOGY_RING
+                ? (island->index + islands->count - 1) % islands->count
+                : (island->index + 1 + ga_random_number(random, islands->count - 1)) % islands->count;
+            _island_emigrate(island, _islands_outbox(islands, island->index, migration));
+            if (!_islands_wait(islands)) {
+                break;
+            }
+            _island_immigrate(island, _islands_outbox(islands, source, migration));
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Runs the islands of an archipelago, one thread per island, the calling one included.
+ * @param islands the archipelago.
+ * @return the reason why the run stopped.
+ */
+static StopReason _islands_run(Islands *islands) {
+    unsigned int started = 1;
+    islands->waiting = 0;
+    islands->phase = 0;
+    islands->reason = GA_STOP_GENERATIONS;
+    islands->start = _now();
+    atomic_store(&islands->abort, false);
+    atomic_store(&islands->best, UINT_MAX);
+    atomic_store(&islands->improvements, 0);
+    atomic_store(&islands->evaluations, 0);
+    while (started < islands->count &&
+           pthread_create(&islands->islands[started].thread, NULL, _island_worker, &islands->islands[started]) == 0) {
+        started++;
+    }
+    if (started < islands->count) {
+        _islands_stop(islands, GA_STOP_ERROR);
+    } else {
+        _island_worker(&islands->islands[0]);
+    }
+    for (unsigned int i = 1; i < started; i++) {
+        pthread_join(islands->islands[i].thread, NULL);
+    }
+    return islands->reason;
+}
+
+/**
+ * Evolves the populations of an archipelago for a number of generations, one thread per island, the calling one
+ * included.
+ * @param islands the archipelago.
+ * @param generations the number of generations.
+ * @param cross_over the cross-over rate.
+ * @param mutation the mutation rate.
+ * @param evaluate the evaluation function.
+ * @param problem the problem given to the evaluation function.
+ * @return the archipelago or NULL if the threads cannot be started.
+ */
+Islands *ga_islands_evolve(Islands *islands, unsigned int generations, const float cross_over,
+                           const float mutation, EvaluateFunction evaluate, const void *problem) {
+    islands->criteria = NULL;
+    islands->generations = generations;
+    islands->cross_over = cross_over;
+    islands->mutation = mutation;
+    islands->evaluate = evaluate;
+    islands->problem = problem;
+    return _islands_run(islands) == GA_STOP_ERROR ? NULL : islands;
+}
+
+/**
+ * Evolves the populations of an archipelago until one of the stop criteria is met by the archipelago, one thread
+ * per island, the calling one included. The generations are counted per island.
+ * @param islands the archipelago.
+ * @param criteria the stop criteria.
+ * @param cross_over the cross-over rate.
+ * @param mutation the mutation rate.
+ * @param evaluate the evaluation function.
+ * @param problem the problem given to the evaluation function.
+ * @return the reason why the run stopped (GA_STOP_ERROR if the threads cannot be started).
+ */
+StopReason ga_islands_run(Islands *islands, const StopCriteria *criteria, const float cross_over,
+                          const float mutation, EvaluateFunction evaluate, const void *problem) {
+    islands->criteria = criteria;
+    islands->cross_over = cross_over;
+    islands->mutation = mutation;
+    islands->evaluate = evaluate;
+    islands->problem = problem;
+    return _islands_run(islands);
+}
+
+/**
+ * Gets the solver of the island which found the best individual of an archipelago.
+ * @param islands the archipelago.
+ * @return the solver.
+ */
+Solver *ga_islands_get_best(Islands *islands) {
+    Solver *best = islands->islands[0].solver;
+    for (unsigned int i = 1; i < islands->count; i++) {
+        Solver *solver = islands->islands[i].solver;
+        if (solver->best && (!best->best || solver->best_score < best->best_score)) {
+            best = solver;
+        }
+    }
+    return best;
+}
+
+/**
+ * Advances a splitmix64 state, used to expand seeds into generator states.
+ * @param state the state.
+ * @return the next value.
+ */
+static uint64_t _splitmix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Rotates a 64 bits word to the left.
+ * @param x the word.
+ * @param k the number of bits.
+ * @return the rotated word.
+ */
+static inline uint64_t _rotl(const uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * Seeds a random generator (xoshiro256**). Each (seed, stream) pair gives an independent sequence, so
+ * threads or islands sharing a seed use distinct streams.
+ * @param random the random generator.
+ * @param seed the seed.
+ * @param stream the stream number.
+ * @return the random generator.
+ */
+Random *ga_random_seed(Random *random, unsigned long long seed, unsigned long long stream) {
+    uint64_t state = seed;
+    uint64_t mix = stream;
+    state ^= _splitmix64(&mix);
+    for (unsigned int i = 0; i < 4; i++) {
+        random->state[i] = _splitmix64(&state);
+    }
+    return random;
+}
+
+/**
+ * Returns the next 64 random bits of a random generator.
+ * @param random the random generator.
+ * @return the random bits.
+ */
+unsigned long long ga_random_next(Random *random) {
+    uint64_t *s = random->state;
+    const uint64_t result = _rotl(s[1] * 5, 7) * 9;
+    const uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = _rotl(s[3], 45);
+    return result;
+}
+
+/**
+ * Returns an unbiased random number in [0, bound).
+ * @param random the random generator.
+ * @param bound the bound (not null).
+ * @return the random number.
+ */
+unsigned int ga_random_number(Random *random, unsigned int bound) {
+    uint64_t product = (ga_random_next(random) >> 32) * bound;
+    uint32_t low = (uint32_t)product;
+    if (low < bound) {
+        uint32_t threshold = -bound % bound;
+        while (low < threshold) {
+            product = (ga_random_next(random) >> 32) * bound;
+            low = (uint32_t)product;
+        }
+    }
+    return (unsigned int)(product >> 32);
+}
+
+/**
+ * Returns the number of failed trials before the first success of trials succeeding with a probability, so that
+ * rare events are drawn without a random number per trial.
+ * @param random the random generator.
+ * @param probability the probability of a success.
+ * @return the number of failures (UINT_MAX for a null probability).
+ */
+unsigned int ga_random_geometric(Random *random, double probability) {
+    double failures;
+    if (probability >= 1) {
+        return 0;
+    } else if (probability <= 0) {
+        return UINT_MAX;
+    }
+    /* inversion of the distribution, 1 - u being in (0, 1] */
+    failures = floor(log(1 - ga_random_unit(random)) / log1p(-probability));
+    return failures < UINT_MAX ? (unsigned int)failures : UINT_MAX;
+}
+
+/**
+ * Returns a random double in [0, 1).
+ * @param random the random generator.
+ * @return the random number.
+ */
+double ga_random_unit(Random *random) {
+    return (double)(ga_random_next(random) >> 11) * 0x1.0p-53;
+}
+
+/**
+ * Fills an array with random 32 bits words, two per draw of the generator.
+ * @param random the random generator.
+ * @param values the array.
+ * @param count the number of words.
+ */
+void ga_random_fill(Random *random, unsigned int *values, size_t count) {
+    size_t i = 0;
+    for (; i + 1 < count; i += 2) {
+        uint64_t bits = ga_random_next(random);
+        values[i] = (unsigned int)bits;
+        values[i + 1] = (unsigned int)(bits >> 32);
+    }
+    if (i < count) {
+        values[i] = (unsigned int)(ga_random_next(random) >> 32);
+    }
+}
+
+/**
+ * Fills an array with random floats in [0, 1).
+ * @param random the random generator.
+ * @param values the array.
+ * @param count the number of floats.
+ */
+void ga_random_fill_float(Random *random, float *values, size_t count) {
+    size_t i = 0;
+    for (; i + 1 < count; i += 2) {
+        uint64_t bits = ga_random_next(random);
+        values[i] = (float)(bits & 0xFFFFFF) * 0x1.0p-24f;
+        values[i + 1] = (float)(bits >> 40) * 0x1.0p-24f;
+    }
+    if (i < count) {
+        values[i] = (float)(ga_random_next(random) >> 40) * 0x1.0p-24f;
+    }
+}
+
+/**
+ * Seeds the default random generators. The calling thread gets the stream 0 and the other threads
+ * the following streams, in the order they next draw a number.
+ * @param seed the seed.
+ */
+void ga_seed(unsigned long long seed) {
+    random_seed = seed;
+    atomic_store(&random_streams, 1);
+    atomic_fetch_add(&random_epoch, 1);
+    ga_random_seed(&thread_random, seed, 0);
+    thread_epoch = atomic_load(&random_epoch);
+}
+
+/**
+ * Returns the default random generator of the calling thread.
+ * @return the random generator.
+ */
+Random *ga_random_default(void) {
+    unsigned int epoch = atomic_load(&random_epoch);
+    if (thread_epoch != epoch) {
+        ga_random_seed(&thread_random, random_seed, atomic_fetch_add(&random_streams, 1));
+        thread_epoch = epoch;
+    }
+    return &thread_random;
+}
+
+/**
+ * Returns a random int number in a given interval.
+ * @param min_num the lowest number of the interval
+ * @param max_num the highest number of the interval
+ * @return the random number
+ */
+int random_number(int min_num, int max_num)
+{
+    int low_num = 0, hi_num = 0;
+    if (min_num == max_num)
+    {
+        return min_num;
+    }
+    else if (min_num < max_num)
+    {
+        low_num = min_num;
+        hi_num = max_num + 1;
+    } else {
+        low_num = max_num + 1;
+        hi_num = min_num;
+    }
+    return (int)ga_random_number(ga_random_default(), (unsigned int)(hi_num - low_num)) + low_num;
+}
+
+/**
+ * Returns a random float number in a given interval
+ * @param min the lowest number of the interval
+ * @param max the highest number of the interval
+ * @return the random float.
  */
 float random_float(const float min, const float max)
 {
     if (max == min) return min;
-    else if (min < max) return (max - min) * ((float)rand() / RAND_MAX) + min;
+    else if (min < max) return (max - min) * (float)ga_random_unit(ga_random_default()) + min;
     return 0;
-}
\ No newline at end of file
+}
@@ -4,10 +4,146 @@
 #include <stdbool.h>
 #include <stdio.h>
 
+/**
+ * The maximum number of genomes given to a batch evaluation function.
+ */
+#define GA_BATCH_SIZE 32
+
+/**
+ * The default number of generations between two migrations of an archipelago.
+ */
+#define GA_MIGRATION_INTERVAL 10
+
+/**
+ * The default number of individuals sent by each island of an archipelago on a migration.
+ */
+#define GA_MIGRANTS 2
+
+/**
+ * The version of the checkpoint format, bumped on every change of its layout.
+ */
+#define GA_CHECKPOINT_VERSION 2
+
+/**
+ * The version of the generator format, bumped on every change of its layout.
+ */
+#define GA_GENERATOR_VERSION 1
+
+/**
+ * Whether the solvers asking for it record the statistics of their generations. Building with
+ * GA_INSTRUMENTATION defined to 0 removes the timers and the counters from the generation loop.
+ */
+#ifndef GA_INSTRUMENTATION
+#define GA_INSTRUMENTATION 1
+#endif
+
 typedef struct _GeneticGenerator GeneticGenerator;
 typedef struct _Population Population;
 typedef struct _Individual Individual;
 typedef struct _Fortune_Rank Fortune_Rank;
+typedef struct _Lineage Lineage;
+typedef struct _FitnessCache FitnessCache;
+typedef struct _Instrumentation Instrumentation;
+typedef struct _ThreadPool ThreadPool;
+typedef struct _Random Random;
+typedef struct _Solver Solver;
+typedef struct _Island Island;
+typedef struct _Islands Islands;
+
+typedef enum {
+    GA_LOCAL_SEARCH_BEST,
+    GA_LOCAL_SEARCH_RANDOM
+} LocalSearchSelection;
+
+typedef enum {
+    GA_SELECTION_ROULETTE,
+    GA_SELECTION_TOURNAMENT,
+    GA_SELECTION_RANK,
+    GA_SELECTION_TRUNCATION
+} SelectionStrategy;
+
+typedef enum {
+    GA_STOP_NONE,
+    GA_STOP_TARGET,
+    GA_STOP_GENERATIONS,
+    GA_STOP_STAGNATION,
+    GA_STOP_TIME,
+    GA_STOP_EVALUATIONS,
+    GA_STOP_ERROR
+} StopReason;
+
+/**
+ * The stop criteria of a run. A run stops once its best score is at most the target, and once any other
+ * criterion that is not 0 is met.
+ */
+typedef struct {
+    unsigned int generations;
+    unsigned int target;
+    unsigned int stagnation;
+    double time;
+    unsigned long long evaluations;
+} StopCriteria;
+
+typedef enum {
+    GA_PHASE_EVALUATION,
+    GA_PHASE_LOCAL_SEARCH,
+    GA_PHASE_SURVIVAL,
+    GA_PHASE_SELECTION,
+    GA_PHASE_CLONING,
+    GA_PHASE_CROSS_OVER,
+    GA_PHASE_MUTATION,
+    GA_PHASE_BOOKKEEPING,
+    GA_PHASES
+} Phase;
+
+typedef enum {
+    GA_STATISTICS_CSV,
+    GA_STATISTICS_JSON
+} StatisticsFormat;
+
+/**
+ * The statistics of a generation: the wall-clock time spent in each phase in seconds, the individuals evaluated
+ * and found in the fitness cache, the memory allocated with ga_malloc and ga_realloc by every thread working on
+ * the generation (functions called back included), and the best, mean and worst ratings.
+ */
+typedef struct {
+    unsigned int generation;
+    double phases[GA_PHASES];
+    unsigned long long evaluations;
+    unsigned long long cache_hits;
+    unsigned long long allocations;
+    unsigned long long bytes;
+    unsigned int best;
+    double mean;
+    unsigned int worst;
+} GenerationStatistics;
+
+/**
+ * The progress of a run, reported every few generations to the progress function of its solver.
+ */
+typedef struct {
+    unsigned int generation;
+    unsigned int best_score;
+    unsigned long long evaluations;
+    const GenerationStatistics *statistics;
+} Progress;
+
+typedef enum {
+    GA_TOPOLOGY_RING,
+    GA_TOPOLOGY_RANDOM
+} Topology;
+
+typedef unsigned int (*EvaluateFunction)(const void *genome, const void *problem);
+typedef unsigned int (*DeltaEvaluateFunction)(const void *parent, unsigned int note, const void *child,
+                                              const unsigned int *changes, unsigned int count, const void *problem);
+typedef unsigned int (*LocalSearchFunction)(void *genome, unsigned int note, const void *problem, Random *random);
+typedef void (*BatchEvaluateFunction)(const void *const *genomes, unsigned int count, unsigned int *notes,
+                                      const void *problem);
+typedef void (*CrossOverFunction)(const GeneticGenerator *generator, unsigned int width, void *sister, void *brother,
+                                  float rate, Random *random, const void *problem);
+typedef void (*MutationFunction)(const GeneticGenerator *generator, unsigned int width, void *genome, float rate,
+                                 Random *random, const void *problem);
+typedef void (*ProgressFunction)(const Progress *progress, void *data);
 
 extern void *(*ga_malloc)(size_t size);
 extern void *(*ga_realloc)(void *ptr, size_t size);
@@ -22,7 +158,15 @@ extern void genetic_generator_destroy(GeneticGenerator *generator);
 extern GeneticGenerator *genetic_generator_set_cardinality(GeneticGenerator *generator, const unsigned int index,
                                                            const unsigned int cardinality);
 extern unsigned int genetic_generator_get_cardinality(const GeneticGenerator *generator, const unsigned int index);
+extern GeneticGenerator *genetic_generator_set_segment(GeneticGenerator *generator, const unsigned int begin,
+                                                       const unsigned int length, const unsigned int *values);
+extern unsigned int genetic_generator_get_segment(const GeneticGenerator *generator, const unsigned int index);
+extern GeneticGenerator *genetic_generator_set_domain(GeneticGenerator *generator, const unsigned int index,
+                                                      const unsigned int *values, const unsigned int count);
+extern const unsigned int *genetic_generator_get_domain(const GeneticGenerator *generator, const unsigned int index,
+                                                        unsigned int *count);
 extern unsigned int genetic_generator_get_size(const GeneticGenerator *generator);
+extern unsigned int genetic_generator_get_width(const GeneticGenerator *generator);
 
 extern GeneticGenerator *genetic_generator_clone(const GeneticGenerator *genetic_generator);
 extern GeneticGenerator *genetic_generator_copy(GeneticGenerator *dest, const GeneticGenerator *src);
@@ -32,16 +176,99 @@ extern GeneticGenerator *genetic_generator_fread(GeneticGenerator *generator, FI
 
 extern const char *genetic_generator_to_string(const GeneticGenerator *generator);
 
-extern unsigned int* genetic_generator_individual(const GeneticGenerator* generator);
-extern Population* ga_population_create(const GeneticGenerator* generator,unsigned int size);
+extern ThreadPool *ga_thread_pool_create(unsigned int threads);
+extern void ga_thread_pool_destroy(ThreadPool *pool);
+extern unsigned int ga_thread_pool_get_size(const ThreadPool *pool);
+
+extern Solver *ga_solver_create(unsigned long long seed);
+extern void ga_solver_destroy(Solver *solver);
+extern Solver *ga_solver_reset(Solver *solver, unsigned long long seed, unsigned long long stream);
+extern Solver *ga_solver_set_verbose(Solver *solver, bool verbose);
+extern Solver *ga_solver_set_progress(Solver *solver, ProgressFunction progress, unsigned int interval, void *data);
+extern void ga_progress_print(const Progress *progress, void *data);
+extern Solver *ga_solver_set_threads(Solver *solver, unsigned int threads);
+extern Solver *ga_solver_set_thread_pool(Solver *solver, ThreadPool *pool);
+extern Solver *ga_solver_set_delta_evaluate(Solver *solver, DeltaEvaluateFunction evaluate_delta, unsigned int limit);
+extern Solver *ga_solver_set_batch_evaluate(Solver *solver, BatchEvaluateFunction evaluate_batch);
+extern Solver *ga_solver_set_cross_over(Solver *solver, CrossOverFunction cross_over);
+extern Solver *ga_solver_set_mutation(Solver *solver, MutationFunction mutation);
+extern Solver *ga_solver_set_selection(Solver *solver, SelectionStrategy strategy, float parameter);
+extern Solver *ga_solver_set_elitism(Solver *solver, unsigned int elites);
+extern Solver *ga_solver_set_steady_state(Solver *solver, float replacement);
+extern Solver *ga_solver_set_local_search(Solver *solver, LocalSearchFunction local_search, float fraction,
+                                          LocalSearchSelection selection);
+extern double ga_solver_get_local_search_time(const Solver *solver);
+extern unsigned long long ga_solver_get_evaluations(const Solver *solver);
+extern Solver *ga_solver_set_cache(Solver *solver, unsigned int capacity);
+extern unsigned long long ga_solver_get_cache_lookups(const Solver *solver);
+extern unsigned long long ga_solver_get_cache_hits(const Solver *solver);
+extern Solver *ga_solver_set_instrumentation(Solver *solver, unsigned int history);
+extern const GenerationStatistics *ga_solver_get_statistics(const Solver *solver, unsigned int age);
+extern const GenerationStatistics *ga_solver_get_total_statistics(const Solver *solver);
+extern bool ga_solver_statistics_fwrite(const Solver *solver, FILE *stream, StatisticsFormat format);
+extern const char *ga_phase_to_string(Phase phase);
+extern Random *ga_solver_get_random(Solver *solver);
+extern unsigned int ga_solver_get_generation(const Solver *solver);
+
+extern unsigned int ga_genome_get(const void *genome, unsigned int width, unsigned int index);
+extern void ga_genome_set(void *genome, unsigned int width, unsigned int index, unsigned int value);
+
+extern void *genetic_generator_individual(const GeneticGenerator* generator);
+extern Population* ga_population_create(Solver *solver, const GeneticGenerator* generator,unsigned int size);
 extern void ga_population_destroy(Population* population);
-extern Population* ga_population_next(Population* population,const float cross_over,const float mutation,unsigned int (*evaluate)(unsigned int *, const void*),const void *problem);
-extern Individual *get_random_individual(Fortune_Rank *ranks, int size, int sum_of_fitness);
+extern Population* ga_population_next(Solver *solver, Population* population,const float cross_over,const float mutation,EvaluateFunction evaluate,const void *problem);
+extern double ga_fortune_wheel_build(Fortune_Rank *ranks, unsigned int size, unsigned long long sum_of_fitness);
+extern void ga_cross_over_uniform(const GeneticGenerator *generator, unsigned int width, void *sister, void *brother,
+                                  float rate, Random *random, const void *problem);
+extern void ga_cross_over_one_point(const GeneticGenerator *generator, unsigned int width, void *sister,
+                                    void *brother, float rate, Random *random, const void *problem);
+extern void ga_cross_over_two_point(const GeneticGenerator *generator, unsigned int width, void *sister,
+                                    void *brother, float rate, Random *random, const void *problem);
+extern void ga_cross_over_segment(const GeneticGenerator *generator, unsigned int width, void *sister, void *brother,
+                                  float rate, Random *random, const void *problem);
+extern void ga_mutation_reset(const GeneticGenerator *generator, unsigned int width, void *genome, float rate,
+                              Random *random, const void *problem);
+extern void ga_mutation_swap(const GeneticGenerator *generator, unsigned int width, void *genome, float rate,
+                             Random *random, const void *problem);
+extern void ga_mutation_creep(const GeneticGenerator *generator, unsigned int width, void *genome, float rate,
+                              Random *random, const void *problem);
+extern Individual *get_random_individual(Random *random, const Fortune_Rank *ranks, unsigned int size);
 extern void ga_individual_destroy(Individual* individual);
 extern Population* ga_population_clone(const Population *population);
 extern Individual* ga_individual_clone(const Individual *individual);
-extern int get_best_score();
-extern Individual* get_best_individual();
+extern unsigned int ga_individual_get(const Individual *individual, unsigned int index);
+extern Individual *ga_individual_set(Individual *individual, unsigned int index, unsigned int value);
+extern Population *ga_checkpoint_fwrite(const Solver *solver, const Population *population, FILE *stream);
+extern Population *ga_checkpoint_fread(Solver *solver, FILE *stream);
+extern StopReason ga_run(Solver *solver, Population *population, const StopCriteria *criteria, const float cross_over,
+                         const float mutation, EvaluateFunction evaluate, const void *problem);
+extern const char *ga_stop_reason_to_string(StopReason reason);
+extern unsigned int get_best_score(const Solver *solver);
+extern Individual* get_best_individual(const Solver *solver);
+
+extern Islands *ga_islands_create(const GeneticGenerator *generator, unsigned int count, unsigned int size,
+                                  unsigned long long seed);
+extern void ga_islands_destroy(Islands *islands);
+extern Islands *ga_islands_set_migration(Islands *islands, unsigned int interval, unsigned int migrants,
+                                         Topology topology);
+extern unsigned int ga_islands_get_count(const Islands *islands);
+extern Solver *ga_islands_get_solver(Islands *islands, unsigned int index);
+extern Population *ga_islands_get_population(Islands *islands, unsigned int index);
+extern Islands *ga_islands_evolve(Islands *islands, unsigned int generations, const float cross_over,
+                                  const float mutation, EvaluateFunction evaluate, const void *problem);
+extern StopReason ga_islands_run(Islands *islands, const StopCriteria *criteria, const float cross_over,
+                                 const float mutation, EvaluateFunction evaluate, const void *problem);
+extern Solver *ga_islands_get_best(Islands *islands);
+
+extern void ga_seed(unsigned long long seed);
+extern Random *ga_random_default(void);
+extern Random *ga_random_seed(Random *random, unsigned long long seed, unsigned long long stream);
+extern unsigned long long ga_random_next(Random *random);
+extern unsigned int ga_random_number(Random *random, unsigned int bound);
+extern double ga_random_unit(Random *random);
+extern void ga_random_fill(Random *random, unsigned int *values, size_t count);
+extern unsigned int ga_random_geometric(Random *random, double probability);
+extern void ga_random_fill_float(Random *random, float *values, size_t count);
 
 extern int random_number(int min, int max);
 extern float random_float(float min, float max);
@@ -0,0 +1,361 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <yaml.h>
+#include "ga.h"
+#include "ga.inc"
+#include "sudoku.h"
+#include "batch.h"
+
+/**
+ * The number of bytes of progress reports buffered before they are written.
+ */
+#define REPORT_BUFFER_SIZE 4096
+
+/**
+ * The progress reports of a run, buffered in memory and written by blocks.
+ */
+typedef struct {
+
+    FILE *stream;
+    char buffer[REPORT_BUFFER_SIZE];
+    size_t length;
+
+} Report;
+
+/**
+ * Writes the buffered progress reports.
+ * @param report the reports.
+ */
+static void report_flush(Report *report){
+
+    fwrite(report->buffer, 1, report->length, report->stream);
+    report->length = 0;
+
+}
+
+/**
+ * Buffers a progress report: the generation, the best score and the number of evaluations.
+ * @param progress the progress of the run.
+ * @param data the reports.
+ */
+static void report_progress(const Progress *progress, void *data){
+
+    Report *report = data;
+
+    /* a report takes less than 128 bytes */
+    if (report->length + 128 > REPORT_BUFFER_SIZE)
+        report_flush(report);
+
+    int length = snprintf(report->buffer + report->length, REPORT_BUFFER_SIZE - report->length,
+                          "Generation %u : best score %u, %llu evaluations\n",
+                          progress->generation, progress->best_score, progress->evaluations);
+
+    if (length > 0)
+        report->length += (size_t)length;
+
+}
+
+/**
+ * Solves every puzzle of a file (one per line, "-" for the standard input) and reports each of them, then
+ * a summary of the batch.
+ * Usage: sudoku --batch file [cross-over] [mutation] [individuals] [generations] [workers] [seed] [stagnation]
+ * [seconds]
+ */
+static int batch_main(int argc, char **argv){
+
+    BatchSettings settings = {.cross_over = 0.5f, .mutation = 0.01f, .individuals = 1000, .generations = 1000,
+                              .workers = 0, .local_search = SUDOKU_LOCAL_SEARCH_FRACTION,
+                              .cross_over_operator = sudoku_cross_over_guided, .cache = SUDOKU_CACHE_CAPACITY};
+    unsigned int count;
+
+    if (argc < 2) {
+        fputs("Usage: sudoku --batch file [cross-over] [mutation] [individuals] [generations] [workers] [seed]"
+              " [stagnation] [seconds]\n", stderr);
+        return EXIT_FAILURE;
+    }
+
+    if (argc > 2)
+        sscanf(argv[2], "%f", &settings.cross_over);
+    if (argc > 3)
+        sscanf(argv[3], "%f", &settings.mutation);
+    if (argc > 4)
+        sscanf(argv[4], "%u", &settings.individuals);
+    if (argc > 5)
+        sscanf(argv[5], "%u", &settings.generations);
+    if (argc > 6)
+        sscanf(argv[6], "%u", &settings.workers);
+    if (argc > 7)
+        sscanf(argv[7], "%llu", &settings.seed);
+    if (argc > 8)
+        sscanf(argv[8], "%u", &settings.stagnation);
+    if (argc > 9)
+        sscanf(argv[9], "%lf", &settings.time);
+
+    FILE *fh = strcmp(argv[1], "-") == 0 ? stdin : fopen(argv[1], "r");
+
+    if (fh == NULL) {
+        fputs("Failed to open file!\n", stderr);
+        return EXIT_FAILURE;
+    }
+
+    unsigned int *puzzles = sudoku_batch_read(fh, &count);
+
+    if (fh != stdin)
+        fclose(fh);
+
+    BatchResult *results = malloc(sizeof(BatchResult) * (count ? count : 1));
+
+    if (!puzzles || !results) {
+        fputs("Failed to load the puzzles!\n", stderr);
+        free(puzzles);
+        free(results);
+        return EXIT_FAILURE;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    bool solved = sudoku_batch_solve(puzzles, count, &settings, results, stdout);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (solved)
+        sudoku_batch_summary(results, count, (double)(end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9, stdout);
+    else
+        fputs("Failed to solve the puzzles!\n", stderr);
+
+    free(results);
+    free(puzzles);
+
+    return solved ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
+
+int main(int argc, char **argv){
+
+    ga_init();
+
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0) {
+
+        int status = batch_main(argc - 1, argv + 1);
+        ga_finish();
+        return status;
+
+    }
+
+    FILE* fh = fopen(argv[1], "r");
+    yaml_parser_t parser;
+    yaml_token_t token;
+    if (!yaml_parser_initialize(&parser))
+        fputs("Failed to initialize parser!\n", stderr);
+    if (fh == NULL)
+        fputs("Failed to open file!\n", stderr);
+    yaml_parser_set_input_file(&parser, fh);
+
+    unsigned int *sudoku = malloc(sizeof(unsigned int) * 81);
+
+    int index = 0;
+
+    do {
+
+        int state = 0;
+        char* tk;
+
+        yaml_parser_scan(&parser, &token);
+        switch(token.type)
+        {
+            case YAML_KEY_TOKEN:     state = 0; break;
+            case YAML_VALUE_TOKEN:   state = 1; break;
+            case YAML_SCALAR_TOKEN:
+                tk = token.data.scalar.value;
+                if (state == 0) {
+                    if (strcmp(tk, "null") == 0){
+                        tk = "0";
+                    }
+                    int value;
+                    sscanf(tk, "%d", &value);
+                    sudoku[index] = (int)value;
+                    index++;
+                }
+                break;
+            default: break;
+        }
+        if (token.type != YAML_STREAM_END_TOKEN)
+            yaml_token_delete(&token);
+    } while (token.type != YAML_STREAM_END_TOKEN);
+    yaml_token_delete(&token);
+
+    yaml_parser_delete(&parser);
+
+    printf("Loaded Sudoku : \n");
+
+    for(int i = 0; i < 9; i++){
+
+        unsigned int *row = get_row(sudoku, i);
+
+        for(int y = 0; y < 9; y++){
+
+            printf("%d ", row[y]);
+
+        }
+
+        printf("\n");
+
+    };
+
+    Sudoku *problem = sudoku_create(sudoku);
+    GeneticGenerator* gen = sudoku_generator(problem);
+
+    printf("Searching %u free cells\n", problem->size);
+
+    float cross_over;
+    float mutation;
+    int individuals;
+    int generations;
+
+    sscanf(argv[2], "%f", &cross_over);
+    sscanf(argv[3], "%f", &mutation);
+    sscanf(argv[4], "%d", &individuals);
+    sscanf(argv[5], "%d", &generations);
+
+    unsigned long long seed = 0;
+    unsigned int count = 1;
+
+    if (argc > 7)
+        sscanf(argv[7], "%llu", &seed);
+
+    if (argc > 8)
+        sscanf(argv[8], "%u", &count);
+
+    StopCriteria criteria = {generations > 0 ? (unsigned int) generations : 1, 0, 0, 0, 0};
+    StopReason reason;
+
+    if (argc > 9)
+        sscanf(argv[9], "%u", &criteria.stagnation);
+
+    if (argc > 10)
+        sscanf(argv[10], "%lf", &criteria.time);
+
+    Solver *solver;
+    Population *population = NULL;
+    Islands *islands = NULL;
+    Report report = {stdout, {0}, 0};
+
+    if (count > 1) {
+
+        printf("Generating %u islands of %d individuals\n", count, individuals);
+
+        islands = ga_islands_create(gen, count, individuals, seed);
+
+        if (islands == NULL) {
+
+            fputs("Failed to create the islands!\n", stderr);
+            genetic_generator_destroy(gen);
+            sudoku_destroy(problem);
+            free(sudoku);
+            return EXIT_FAILURE;
+
+        }
+
+        for(unsigned int i = 0; i < count; i++){
+
+            ga_solver_set_delta_evaluate(ga_islands_get_solver(islands, i), sudoku_fitness_delta, SUDOKU_DELTA_LIMIT);
+            ga_solver_set_batch_evaluate(ga_islands_get_solver(islands, i), sudoku_fitness_batch);
+            ga_solver_set_local_search(ga_islands_get_solver(islands, i), sudoku_local_search,
+                                       SUDOKU_LOCAL_SEARCH_FRACTION, GA_LOCAL_SEARCH_BEST);
+            ga_solver_set_cross_over(ga_islands_get_solver(islands, i), sudoku_cross_over_guided);
+            ga_solver_set_cache(ga_islands_get_solver(islands, i), SUDOKU_CACHE_CAPACITY);
+
+        }
+
+        /* the first island reports for the archipelago */
+        ga_solver_set_progress(ga_islands_get_solver(islands, 0), report_progress, SUDOKU_REPORT_INTERVAL, &report);
+
+        printf("Evolving islands with %f cross-over and %f mutation rates\n", cross_over, mutation);
+
+        reason = ga_islands_run(islands, &criteria, cross_over, mutation, sudoku_fitness, problem);
+        solver = ga_islands_get_best(islands);
+
+    } else {
+
+        solver = ga_solver_create(seed);
+
+        ga_solver_set_delta_evaluate(solver, sudoku_fitness_delta, SUDOKU_DELTA_LIMIT);
+        ga_solver_set_batch_evaluate(solver, sudoku_fitness_batch);
+        ga_solver_set_local_search(solver, sudoku_local_search, SUDOKU_LOCAL_SEARCH_FRACTION, GA_LOCAL_SEARCH_BEST);
+        ga_solver_set_cross_over(solver, sudoku_cross_over_guided);
+        ga_solver_set_cache(solver, SUDOKU_CACHE_CAPACITY);
+        ga_solver_set_progress(solver, report_progress, SUDOKU_REPORT_INTERVAL, &report);
+
+        if (argc > 6) {
+
+            int threads;
+            sscanf(argv[6], "%d", &threads);
+            ga_solver_set_threads(solver, threads);
+            printf("Evaluating with %u threads\n", solver->thread_pool ? ga_thread_pool_get_size(solver->thread_pool) : 1);
+
+        }
+
+        printf("Generating a population of %d individuals\n", individuals);
+
+        population = ga_population_create(solver, gen, individuals);
+
+        if (population == NULL) {
+
+            fputs("Failed to create the population!\n", stderr);
+            ga_solver_destroy(solver);
+            genetic_generator_destroy(gen);
+            sudoku_destroy(problem);
+            free(sudoku);
+            return EXIT_FAILURE;
+
+        }
+
+        printf("Evolving population with %f cross-over and %f mutation rates\n", cross_over, mutation);
+
+        reason = ga_run(solver, population, &criteria, cross_over, mutation, sudoku_fitness, problem);
+
+    }
+
+    report_flush(&report);
+    printf("Stopped on %s after %u generations\n", ga_stop_reason_to_string(reason), ga_solver_get_generation(solver) - 1);
+    printf("Last best score : %u\n", get_best_score(solver));
+    printf("Local search time : %.3f s\n", ga_solver_get_local_search_time(solver));
+    printf("Cache hits : %llu of %llu children\n", ga_solver_get_cache_hits(solver), ga_solver_get_cache_lookups(solver));
+    unsigned char grid[81];
+    sudoku_decode(problem, get_best_individual(solver)->genome, grid);
+
+    for(int i = 0; i < 9; i++){
+
+        printf("- [");
+
+        for(int y = 0; y < 9; y++){
+
+            printf("%u", grid[i * 9 + y]);
+
+            if (y != 8)
+                printf(", ");
+
+        }
+
+        printf("]\n");
+
+    };
+
+    if (islands) {
+
+        ga_islands_destroy(islands);
+
+    } else {
+
+        ga_population_destroy(population);
+        ga_solver_destroy(solver);
+
+    }
+    genetic_generator_destroy(gen);
+    sudoku_destroy(problem);
+    free(sudoku);
+
+    return 0;
+
+}
\ No newline at end of file
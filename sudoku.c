@@ -1,9 +1,61 @@
 #include<stdio.h>
 #include <string.h>
 #include<stdlib.h>
-#include <yaml.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SUDOKU_SIMD
+#endif
 #include "ga.h"
 #include "ga.inc"
+#include "sudoku.h"
+
+/**
+ * The row, column and block of every cell of the sudoku.
+ */
+static const unsigned char cell_units[81][3] = {
+    {0, 0, 0}, {0, 1, 0}, {0, 2, 0}, {0, 3, 1}, {0, 4, 1}, {0, 5, 1}, {0, 6, 2}, {0, 7, 2}, {0, 8, 2},
+    {1, 0, 0}, {1, 1, 0}, {1, 2, 0}, {1, 3, 1}, {1, 4, 1}, {1, 5, 1}, {1, 6, 2}, {1, 7, 2}, {1, 8, 2},
+    {2, 0, 0}, {2, 1, 0}, {2, 2, 0}, {2, 3, 1}, {2, 4, 1}, {2, 5, 1}, {2, 6, 2}, {2, 7, 2}, {2, 8, 2},
+    {3, 0, 3}, {3, 1, 3}, {3, 2, 3}, {3, 3, 4}, {3, 4, 4}, {3, 5, 4}, {3, 6, 5}, {3, 7, 5}, {3, 8, 5},
+    {4, 0, 3}, {4, 1, 3}, {4, 2, 3}, {4, 3, 4}, {4, 4, 4}, {4, 5, 4}, {4, 6, 5}, {4, 7, 5}, {4, 8, 5},
+    {5, 0, 3}, {5, 1, 3}, {5, 2, 3}, {5, 3, 4}, {5, 4, 4}, {5, 5, 4}, {5, 6, 5}, {5, 7, 5}, {5, 8, 5},
+    {6, 0, 6}, {6, 1, 6}, {6, 2, 6}, {6, 3, 7}, {6, 4, 7}, {6, 5, 7}, {6, 6, 8}, {6, 7, 8}, {6, 8, 8},
+    {7, 0, 6}, {7, 1, 6}, {7, 2, 6}, {7, 3, 7}, {7, 4, 7}, {7, 5, 7}, {7, 6, 8}, {7, 7, 8}, {7, 8, 8},
+    {8, 0, 6}, {8, 1, 6}, {8, 2, 6}, {8, 3, 7}, {8, 4, 7}, {8, 5, 7}, {8, 6, 8}, {8, 7, 8}, {8, 8, 8}
+};
+
+/**
+ * The cells of the 9 rows, 9 columns and 9 blocks of the sudoku.
+ */
+static const unsigned char unit_cells[27][9] = {
+    { 0,  1,  2,  3,  4,  5,  6,  7,  8},
+    { 9, 10, 11, 12, 13, 14, 15, 16, 17},
+    {18, 19, 20, 21, 22, 23, 24, 25, 26},
+    {27, 28, 29, 30, 31, 32, 33, 34, 35},
+    {36, 37, 38, 39, 40, 41, 42, 43, 44},
+    {45, 46, 47, 48, 49, 50, 51, 52, 53},
+    {54, 55, 56, 57, 58, 59, 60, 61, 62},
+    {63, 64, 65, 66, 67, 68, 69, 70, 71},
+    {72, 73, 74, 75, 76, 77, 78, 79, 80},
+    { 0,  9, 18, 27, 36, 45, 54, 63, 72},
+    { 1, 10, 19, 28, 37, 46, 55, 64, 73},
+    { 2, 11, 20, 29, 38, 47, 56, 65, 74},
+    { 3, 12, 21, 30, 39, 48, 57, 66, 75},
+    { 4, 13, 22, 31, 40, 49, 58, 67, 76},
+    { 5, 14, 23, 32, 41, 50, 59, 68, 77},
+    { 6, 15, 24, 33, 42, 51, 60, 69, 78},
+    { 7, 16, 25, 34, 43, 52, 61, 70, 79},
+    { 8, 17, 26, 35, 44, 53, 62, 71, 80},
+    { 0,  1,  2,  9, 10, 11, 18, 19, 20},
+    { 3,  4,  5, 12, 13, 14, 21, 22, 23},
+    { 6,  7,  8, 15, 16, 17, 24, 25, 26},
+    {27, 28, 29, 36, 37, 38, 45, 46, 47},
+    {30, 31, 32, 39, 40, 41, 48, 49, 50},
+    {33, 34, 35, 42, 43, 44, 51, 52, 53},
+    {54, 55, 56, 63, 64, 65, 72, 73, 74},
+    {57, 58, 59, 66, 67, 68, 75, 76, 77},
+    {60, 61, 62, 69, 70, 71, 78, 79, 80}
+};
 
 /**
  * Gets the wanted line in the sudoku
@@ -91,185 +143,1002 @@ int count_occurrences(const unsigned int *sd, int n, int x)
 
 /**
  * Tests a solution given by an individual and gives a rating based on the solution compared to the problem.
- * @param solution an attempt at a solved sudoku given by an individual
+ * The solution holds one byte per cell, the compact genome of the 81 cells of cardinality 9. Every digit
+ * appearing more than once in a row, a column or a block costs one point per extra occurrence, computed in a
+ * single pass with 9 bits occupancy masks, and every given cell that is not respected costs two.
+ * @param genome an attempt at a solved sudoku given by an individual
  * @param problem the initial sudoku given by the user
  * @return the rating of the individual
  */
-unsigned int fitness(unsigned int *solution, const void *problem){
+unsigned int fitness(const void *genome, const void *problem){
+
+    const unsigned char *solution = genome;
+    const unsigned int *sudoku = problem;
+    unsigned int masks[3][9] = {{0}};
+    unsigned int digits = 0;
+    unsigned int note = 0;
 
-    int note = 0;
+    for(int i = 0; i < 81; i++){
+
+        unsigned int value = solution[i];
 
-    unsigned int *sudoku = (unsigned int *)problem;
+        if (value - 1 < 9) {
+
+            unsigned int bit = 1u << value;
+            masks[0][cell_units[i][0]] |= bit;
+            masks[1][cell_units[i][1]] |= bit;
+            masks[2][cell_units[i][2]] |= bit;
+            digits++;
+
+        }
+
+        if (sudoku[i] && value != sudoku[i]) {
+
+            note += 2;
+
+        }
+
+    }
+
+    note += 3 * digits;
 
     for(int i = 0; i < 9; i++){
 
-        unsigned int *row = get_row(solution, i);
-        unsigned int *column = get_column(solution, i);
-        unsigned int *block = get_block(solution, i);
+        note -= __builtin_popcount(masks[0][i]) + __builtin_popcount(masks[1][i]) + __builtin_popcount(masks[2][i]);
 
-        for(int t = 1; t < 10; t++){
+    }
 
-            if (count_occurrences(row, 9, t) > 1) {
+    return note;
 
-                note += count_occurrences(row, 9, t) - 1;
+}
 
-            }
+/**
+ * Counts the extra occurrences of the digits of a row, a column or a block.
+ * @param solution the sudoku
+ * @param unit the unit (rows, then columns, then blocks)
+ * @return the number of extra occurrences
+ */
+static unsigned int unit_duplicates(const unsigned char *solution, int unit){
+
+    unsigned int mask = 0;
+    unsigned int digits = 0;
+
+    for(int i = 0; i < 9; i++){
+
+        unsigned int value = solution[unit_cells[unit][i]];
+
+        if (value - 1 < 9) {
+
+            mask |= 1u << value;
+            digits++;
+
+        }
+
+    }
+
+    return digits - __builtin_popcount(mask);
+
+}
+
+/**
+ * Rates a solution from the rating of the solution it was derived from, by rating again only the rows,
+ * columns and blocks holding a changed cell. Falls back to fitness when too many cells changed.
+ * @param parent_genome the solution the individual derives from
+ * @param note the rating of the parent
+ * @param genome an attempt at a solved sudoku given by an individual
+ * @param changes the cells where the solution differs from its parent
+ * @param count the number of changed cells
+ * @param problem the initial sudoku given by the user
+ * @return the rating of the individual
+ */
+unsigned int fitness_delta(const void *parent_genome, unsigned int note, const void *genome,
+                           const unsigned int *changes, unsigned int count, const void *problem){
+
+    const unsigned char *parent = parent_genome;
+    const unsigned char *solution = genome;
+    const unsigned int *sudoku = problem;
+    unsigned int affected = 0;
+
+    if (count > SUDOKU_DELTA_LIMIT) {
+
+        return fitness(genome, problem);
+
+    }
+
+    for(unsigned int i = 0; i < count; i++){
+
+        unsigned int cell = changes[i];
+
+        affected |= 1u << cell_units[cell][0];
+        affected |= 1u << (9 + cell_units[cell][1]);
+        affected |= 1u << (18 + cell_units[cell][2]);
+
+        if (sudoku[cell]) {
+
+            note -= 2 * (parent[cell] != sudoku[cell]);
+            note += 2 * (solution[cell] != sudoku[cell]);
+
+        }
+
+    }
+
+    while (affected) {
+
+        int unit = __builtin_ctz(affected);
+
+        note -= unit_duplicates(parent, unit);
+        note += unit_duplicates(solution, unit);
+        affected &= affected - 1;
+
+    }
+
+    return note;
+
+}
+
+#ifdef SUDOKU_SIMD
+
+/**
+ * Transposes a batch of solutions into one byte per board for every cell, values that are not digits
+ * becoming 0. Missing boards are filled with zeroes.
+ * @param solutions the solutions
+ * @param count the number of solutions
+ * @param lanes the number of boards of the transposed batch
+ * @param cells the transposed batch
+ */
+static void transpose(const unsigned char *const *solutions, unsigned int count, unsigned int lanes,
+                      unsigned char cells[81][32]){
+
+    for(unsigned int board = 0; board < lanes; board++){
+
+        for(int i = 0; i < 81; i++){
+
+            unsigned char value = board < count ? solutions[board][i] : 0;
+
+            cells[i][board] = value <= 9 ? value : 0;
+
+        }
+
+    }
+
+}
+
+/**
+ * Computes the rating of a transposed batch from the number of cells that do not repeat a digit of their units
+ * and the number of given cells that are respected.
+ * @param unique the number of cells of the 27 units not repeating a digit, per board
+ * @param respected the number of respected given cells, per board
+ * @param count the number of boards
+ * @param notes the ratings
+ * @param sudoku the initial sudoku given by the user
+ */
+static void batch_notes(const unsigned char *unique, const unsigned char *respected, unsigned int count,
+                        unsigned int *notes, const unsigned int *sudoku){
+
+    unsigned int givens = 0;
+
+    for(int i = 0; i < 81; i++){
+
+        givens += sudoku[i] != 0;
+
+    }
+
+    for(unsigned int board = 0; board < count; board++){
+
+        notes[board] = 243 - unique[board] + 2 * (givens - respected[board]);
+
+    }
+
+}
+
+/**
+ * Rates up to 32 solutions at once with AVX2 instructions, one board per byte lane. Every digit is turned
+ * into a bit of a low (1 to 8) and a high (9) mask with byte shuffles, and a cell repeats a digit of its unit
+ * when its bit is already set in the masks of the unit.
+ * @param solutions the solutions
+ * @param count the number of solutions
+ * @param notes the ratings
+ * @param sudoku the initial sudoku given by the user
+ */
+__attribute__((target("avx2")))
+static void fitness_batch_avx2(const unsigned char *const *solutions, unsigned int count, unsigned int *notes,
+                               const unsigned int *sudoku){
+
+    unsigned char cells[81][32] __attribute__((aligned(32)));
+    unsigned char unique[32] __attribute__((aligned(32)));
+    unsigned char respected[32] __attribute__((aligned(32)));
+    __m256i low[81], high[81];
+    const __m256i low_table = _mm256_setr_epi8(0, 1, 2, 4, 8, 16, 32, 64, (char)128, 0, 0, 0, 0, 0, 0, 0,
+                                               0, 1, 2, 4, 8, 16, 32, 64, (char)128, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i high_table = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+                                                0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i unique_count = zero;
+    __m256i respected_count = zero;
+
+    transpose(solutions, count, 32, cells);
+
+    for(int i = 0; i < 81; i++){
+
+        __m256i value = _mm256_load_si256((const __m256i *)cells[i]);
+
+        low[i] = _mm256_shuffle_epi8(low_table, value);
+        high[i] = _mm256_shuffle_epi8(high_table, value);
+
+        if (sudoku[i]) {
+
+            __m256i given = _mm256_set1_epi8((char)sudoku[i]);
+            respected_count = _mm256_sub_epi8(respected_count, _mm256_cmpeq_epi8(value, given));
+
+        }
+
+    }
+
+    for(int unit = 0; unit < 27; unit++){
+
+        __m256i low_mask = zero;
+        __m256i high_mask = zero;
+
+        for(int i = 0; i < 9; i++){
+
+            int cell = unit_cells[unit][i];
+            __m256i seen = _mm256_or_si256(_mm256_and_si256(low_mask, low[cell]),
+                                           _mm256_and_si256(high_mask, high[cell]));
+
+            unique_count = _mm256_sub_epi8(unique_count, _mm256_cmpeq_epi8(seen, zero));
+            low_mask = _mm256_or_si256(low_mask, low[cell]);
+            high_mask = _mm256_or_si256(high_mask, high[cell]);
+
+        }
+
+    }
+
+    _mm256_store_si256((__m256i *)unique, unique_count);
+    _mm256_store_si256((__m256i *)respected, respected_count);
+    batch_notes(unique, respected, count, notes, sudoku);
+
+}
+
+/**
+ * Rates up to 16 solutions at once with SSSE3 instructions, as fitness_batch_avx2 does.
+ * @param solutions the solutions
+ * @param count the number of solutions
+ * @param notes the ratings
+ * @param sudoku the initial sudoku given by the user
+ */
+__attribute__((target("ssse3")))
+static void fitness_batch_ssse3(const unsigned char *const *solutions, unsigned int count, unsigned int *notes,
+                                const unsigned int *sudoku){
+
+    unsigned char cells[81][32] __attribute__((aligned(16)));
+    unsigned char unique[16] __attribute__((aligned(16)));
+    unsigned char respected[16] __attribute__((aligned(16)));
+    __m128i low[81], high[81];
+    const __m128i low_table = _mm_setr_epi8(0, 1, 2, 4, 8, 16, 32, 64, (char)128, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i high_table = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i unique_count = zero;
+    __m128i respected_count = zero;
+
+    transpose(solutions, count, 16, cells);
+
+    for(int i = 0; i < 81; i++){
+
+        __m128i value = _mm_load_si128((const __m128i *)cells[i]);
+
+        low[i] = _mm_shuffle_epi8(low_table, value);
+        high[i] = _mm_shuffle_epi8(high_table, value);
+
+        if (sudoku[i]) {
+
+            __m128i given = _mm_set1_epi8((char)sudoku[i]);
+            respected_count = _mm_sub_epi8(respected_count, _mm_cmpeq_epi8(value, given));
+
+        }
+
+    }
+
+    for(int unit = 0; unit < 27; unit++){
+
+        __m128i low_mask = zero;
+        __m128i high_mask = zero;
+
+        for(int i = 0; i < 9; i++){
+
+            int cell = unit_cells[unit][i];
+            __m128i seen = _mm_or_si128(_mm_and_si128(low_mask, low[cell]), _mm_and_si128(high_mask, high[cell]));
+
+            unique_count = _mm_sub_epi8(unique_count, _mm_cmpeq_epi8(seen, zero));
+            low_mask = _mm_or_si128(low_mask, low[cell]);
+            high_mask = _mm_or_si128(high_mask, high[cell]);
+
+        }
+
+    }
+
+    _mm_store_si128((__m128i *)unique, unique_count);
+    _mm_store_si128((__m128i *)respected, respected_count);
+    batch_notes(unique, respected, count, notes, sudoku);
+
+}
+
+#endif
+
+/**
+ * Rates a batch of solutions, with the widest SIMD instructions supported by the processor or one by one
+ * with fitness. The initial sudoku must only hold digits and zeroes.
+ * @param genomes the solutions
+ * @param count the number of solutions
+ * @param notes the ratings of the solutions
+ * @param problem the initial sudoku given by the user
+ */
+void fitness_batch(const void *const *genomes, unsigned int count, unsigned int *notes, const void *problem){
+
+    const unsigned char *const *solutions = (const unsigned char *const *)genomes;
+
+    unsigned int lanes = 1;
+
+#ifdef SUDOKU_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+
+        lanes = 32;
+
+    } else if (__builtin_cpu_supports("ssse3")) {
+
+        lanes = 16;
+
+    }
+#endif
+
+    for(unsigned int i = 0; i < count; i += lanes){
+
+        unsigned int batch = count - i < lanes ? count - i : lanes;
+
+#ifdef SUDOKU_SIMD
+        if (lanes == 32) {
+
+            fitness_batch_avx2(solutions + i, batch, notes + i, problem);
+            continue;
+
+        } else if (lanes == 16) {
+
+            fitness_batch_ssse3(solutions + i, batch, notes + i, problem);
+            continue;
+
+        }
+#endif
+
+        notes[i] = fitness(solutions[i], problem);
+
+    }
+
+}
+
+/**
+ * Computes the candidates of the free cells of a sudoku, the digits their row, column and block do not hold yet.
+ * @param givens the digits of the sudoku (0 for a free cell)
+ * @param candidates the candidates of every cell, one bit per digit (0 for a given cell)
+ */
+static void sudoku_candidates(const unsigned int *givens, unsigned short *candidates){
+
+    unsigned int used[27] = {0};
+
+    for(int i = 0; i < 81; i++){
+
+        unsigned int bit = givens[i] ? 1u << givens[i] : 0;
+
+        used[cell_units[i][0]] |= bit;
+        used[9 + cell_units[i][1]] |= bit;
+        used[18 + cell_units[i][2]] |= bit;
+
+    }
+
+    for(int i = 0; i < 81; i++){
+
+        candidates[i] = givens[i] ? 0 : (unsigned short)(0x3FE & ~(used[cell_units[i][0]] |
+                                                                     used[9 + cell_units[i][1]] |
+                                                                     used[18 + cell_units[i][2]]));
+
+    }
+
+}
+
+/**
+ * Encodes a sudoku for the genetic algorithm: the free cells become the loci of the genome, row by row, and their
+ * candidates are eliminated against the givens.
+ * @param givens the initial sudoku given by the user (0 for a free cell)
+ * @return the encoded sudoku or NULL
+ */
+Sudoku *sudoku_create(const unsigned int *givens){
+
+    Sudoku *sudoku = malloc(sizeof(Sudoku));
+
+    if (!sudoku) {
+
+        return NULL;
+
+    }
+
+    for(int i = 0; i < 81; i++){
+
+        sudoku->givens[i] = givens[i] <= 9 ? givens[i] : 0;
+
+    }
+
+    sudoku_candidates(sudoku->givens, sudoku->candidates);
+
+    sudoku->size = 0;
+
+    for(int i = 0; i < 81; i++){
+
+        if (sudoku->givens[i]) {
+
+            sudoku->loci[i] = SUDOKU_GIVEN;
+
+        } else {
+
+            sudoku->cells[sudoku->size] = (unsigned char)i;
+            sudoku->loci[i] = (unsigned char)sudoku->size++;
+
+        }
+
+    }
+
+    return sudoku;
 
-            if (count_occurrences(column, 9, t) > 1) {
+}
+
+/**
+ * Frees an encoded sudoku.
+ * @param sudoku the encoded sudoku
+ */
+void sudoku_destroy(Sudoku *sudoku){
+
+    free(sudoku);
+
+}
 
-                note += count_occurrences(column, 9, t) - 1;
+/**
+ * Creates the generator of the genomes of a sudoku: one chromosome of cardinality 9 per free cell, restricted to
+ * the candidates of the cell, and one permutation segment per row holding the digits its givens miss, so that
+ * the rows hold no duplicate.
+ * @param sudoku the encoded sudoku
+ * @return the generator or NULL
+ */
+GeneticGenerator *sudoku_generator(const Sudoku *sudoku){
+
+    GeneticGenerator *generator = genetic_generator_create(sudoku->size);
+    unsigned int begin = 0;
+
+    if (!generator) {
+
+        return NULL;
+
+    }
+
+    for(unsigned int i = 0; i < sudoku->size; i++){
+
+        unsigned int candidates[9];
+        unsigned int count = 0;
+
+        genetic_generator_set_cardinality(generator, i, 9);
+
+        for(unsigned int digit = 1; digit <= 9; digit++){
+
+            if (sudoku->candidates[sudoku->cells[i]] & (1u << digit)) {
+
+                candidates[count++] = digit;
 
             }
 
-            if (count_occurrences(block, 9, t) > 1) {
+        }
+
+        if (!genetic_generator_set_domain(generator, i, candidates, count)) {
+
+            genetic_generator_destroy(generator);
+            return NULL;
+
+        }
+
+    }
+
+    for(int row = 0; row < 9; row++){
+
+        unsigned int present = 0;
+        unsigned int missing[9];
+        unsigned int length = 0;
+        unsigned int count = 0;
+
+        for(int i = 0; i < 9; i++){
+
+            present |= 1u << sudoku->givens[row * 9 + i];
+            length += sudoku->loci[row * 9 + i] != SUDOKU_GIVEN;
+
+        }
+
+        /* a row repeating a given misses more digits than it has free cells */
+        for(unsigned int digit = 1; digit <= 9 && count < length; digit++){
 
-                note += count_occurrences(block, 9, t) - 1;
+            if (!(present & (1u << digit))) {
+
+                missing[count++] = digit;
 
             }
 
         }
 
-        free(row);
-        free(column);
-        free(block);
+        if (!genetic_generator_set_segment(generator, begin, length, missing)) {
+
+            genetic_generator_destroy(generator);
+            return NULL;
+
+        }
+
+        begin += length;
 
     }
 
+    return generator;
+
+}
+
+/**
+ * Rebuilds the grid of a genome from the givens and the free cells.
+ * @param sudoku the encoded sudoku
+ * @param genome the genome (one byte per free cell)
+ * @param grid the 81 cells of the grid
+ */
+void sudoku_decode(const Sudoku *sudoku, const void *genome, unsigned char *grid){
+
+    const unsigned char *solution = genome;
+
     for(int i = 0; i < 81; i++){
 
-        if (solution[i]!=sudoku[i] && sudoku[i]!=0){
+        grid[i] = (unsigned char)sudoku->givens[i];
 
-            note += 2;
+    }
+
+    for(unsigned int i = 0; i < sudoku->size; i++){
+
+        grid[sudoku->cells[i]] = solution[i];
+
+    }
+
+}
+
+/**
+ * Rates the genome of an encoded sudoku with fitness. The givens are respected by construction.
+ * @param genome an attempt at the free cells of the sudoku given by an individual
+ * @param problem the encoded sudoku
+ * @return the rating of the individual
+ */
+unsigned int sudoku_fitness(const void *genome, const void *problem){
+
+    const Sudoku *sudoku = problem;
+    unsigned char grid[81];
+
+    sudoku_decode(sudoku, genome, grid);
+
+    return fitness(grid, sudoku->givens);
+
+}
+
+/**
+ * Rates a batch of genomes of an encoded sudoku with fitness_batch.
+ * @param genomes the genomes
+ * @param count the number of genomes
+ * @param notes the ratings of the genomes
+ * @param problem the encoded sudoku
+ */
+void sudoku_fitness_batch(const void *const *genomes, unsigned int count, unsigned int *notes, const void *problem){
+
+    const Sudoku *sudoku = problem;
+    unsigned char grids[32][81];
+    const void *batch[32];
+
+    for(unsigned int i = 0; i < count; i += 32){
+
+        unsigned int size = count - i < 32 ? count - i : 32;
+
+        for(unsigned int board = 0; board < size; board++){
+
+            sudoku_decode(sudoku, genomes[i + board], grids[board]);
+            batch[board] = grids[board];
+
+        }
+
+        fitness_batch(batch, size, notes + i, sudoku->givens);
+
+    }
+
+}
+
+/**
+ * Counts the extra occurrences of the digits of a row, a column or a block of the genome of an encoded sudoku.
+ * @param sudoku the encoded sudoku
+ * @param solution the genome
+ * @param unit the unit (rows, then columns, then blocks)
+ * @return the number of extra occurrences
+ */
+static unsigned int sudoku_unit_duplicates(const Sudoku *sudoku, const unsigned char *solution, int unit){
+
+    unsigned int mask = 0;
+    unsigned int digits = 0;
+
+    for(int i = 0; i < 9; i++){
+
+        int cell = unit_cells[unit][i];
+        unsigned int value = sudoku->loci[cell] == SUDOKU_GIVEN ? sudoku->givens[cell] : solution[sudoku->loci[cell]];
+
+        if (value - 1 < 9) {
+
+            mask |= 1u << value;
+            digits++;
 
         }
 
     }
 
+    return digits - __builtin_popcount(mask);
+
+}
+
+/**
+ * Rates the genome of an encoded sudoku from the rating of its parent, as fitness_delta does.
+ * @param parent_genome the genome the individual derives from
+ * @param note the rating of the parent
+ * @param genome an attempt at the free cells of the sudoku given by an individual
+ * @param changes the loci where the genome differs from its parent
+ * @param count the number of changed loci
+ * @param problem the encoded sudoku
+ * @return the rating of the individual
+ */
+unsigned int sudoku_fitness_delta(const void *parent_genome, unsigned int note, const void *genome,
+                                  const unsigned int *changes, unsigned int count, const void *problem){
+
+    const Sudoku *sudoku = problem;
+    unsigned int affected = 0;
+
+    if (count > SUDOKU_DELTA_LIMIT) {
+
+        return sudoku_fitness(genome, problem);
+
+    }
+
+    for(unsigned int i = 0; i < count; i++){
+
+        unsigned int cell = sudoku->cells[changes[i]];
+
+        affected |= 1u << cell_units[cell][0];
+        affected |= 1u << (9 + cell_units[cell][1]);
+        affected |= 1u << (18 + cell_units[cell][2]);
+
+    }
+
+    while (affected) {
+
+        int unit = __builtin_ctz(affected);
+
+        note -= sudoku_unit_duplicates(sudoku, parent_genome, unit);
+        note += sudoku_unit_duplicates(sudoku, genome, unit);
+        affected &= affected - 1;
+
+    }
+
     return note;
 
 }
 
+/**
+ * Improves the genome of an encoded sudoku by hill climbing: the free cells of a row are swapped when both
+ * keep a candidate and the swap lowers the duplicates of their columns and blocks, the rows being unchanged.
+ * The rows are scanned from a random one until a whole pass improves nothing or the sudoku is solved.
+ * @param genome the genome to improve
+ * @param note the rating of the genome
+ * @param problem the encoded sudoku
+ * @param random the random generator
+ * @return the rating of the improved genome
+ */
+unsigned int sudoku_local_search(void *genome, unsigned int note, const void *problem, Random *random){
 
-int main(int argc, char **argv){
+    const Sudoku *sudoku = problem;
+    unsigned char *solution = genome;
+    unsigned char grid[81];
+    unsigned int first = ga_random_number(random, 9);
+    bool improved = true;
 
-    ga_init();
+    sudoku_decode(sudoku, genome, grid);
 
-    FILE* fh = fopen(argv[1], "r");
-    yaml_parser_t parser;
-    yaml_token_t token;
-    if (!yaml_parser_initialize(&parser))
-        fputs("Failed to initialize parser!\n", stderr);
-    if (fh == NULL)
-        fputs("Failed to open file!\n", stderr);
-    yaml_parser_set_input_file(&parser, fh);
+    for(int pass = 0; pass < SUDOKU_CLIMB_PASSES && improved && note; pass++){
 
-    unsigned int *sudoku = malloc(sizeof(unsigned int) * 81);
+        improved = false;
 
-    int index = 0;
+        for(unsigned int r = 0; r < 9 && note; r++){
+
+            unsigned int row = (first + r) % 9;
+
+            for(unsigned int a = row * 9; a < row * 9 + 9; a++){
+
+                for(unsigned int b = a + 1; b < row * 9 + 9 && sudoku->loci[a] != SUDOKU_GIVEN; b++){
+
+                    int units[4] = {9 + cell_units[a][1], 9 + cell_units[b][1],
+                                    18 + cell_units[a][2], 18 + cell_units[b][2]};
+                    int count = units[2] == units[3] ? 3 : 4;
+                    unsigned int before = 0;
+                    unsigned int after = 0;
+                    unsigned char value = grid[a];
+
+                    if (sudoku->loci[b] == SUDOKU_GIVEN || grid[a] == grid[b] ||
+                        !(sudoku->candidates[a] & (1u << grid[b])) || !(sudoku->candidates[b] & (1u << grid[a]))) {
+
+                        continue;
+
+                    }
+
+                    for(int u = 0; u < count; u++){
+
+                        before += unit_duplicates(grid, units[u]);
 
-    do {
-
-        int state = 0;
-        char* tk;
-
-        yaml_parser_scan(&parser, &token);
-        switch(token.type)
-        {
-            case YAML_KEY_TOKEN:     state = 0; break;
-            case YAML_VALUE_TOKEN:   state = 1; break;
-            case YAML_SCALAR_TOKEN:
-                tk = token.data.scalar.value;
-                if (state == 0) {
-                    if (strcmp(tk, "null") == 0){
-                        tk = "0";
                     }
-                    int value;
-                    sscanf(tk, "%d", &value);
-                    sudoku[index] = (int)value;
-                    index++;
+
+                    grid[a] = grid[b];
+                    grid[b] = value;
+
+                    for(int u = 0; u < count; u++){
+
+                        after += unit_duplicates(grid, units[u]);
+
+                    }
+
+                    if (after < before) {
+
+                        solution[sudoku->loci[a]] = grid[a];
+                        solution[sudoku->loci[b]] = grid[b];
+                        note -= before - after;
+                        improved = true;
+
+                    } else {
+
+                        grid[b] = grid[a];
+                        grid[a] = value;
+
+                    }
+
                 }
-                break;
-            default: break;
+
+            }
+
         }
-        if (token.type != YAML_STREAM_END_TOKEN)
-            yaml_token_delete(&token);
-    } while (token.type != YAML_STREAM_END_TOKEN);
-    yaml_token_delete(&token);
 
-    yaml_parser_delete(&parser);
+    }
 
-    printf("Loaded Sudoku : \n");
+    return note;
 
-    for(int i = 0; i < 9; i++){
+}
+
+/**
+ * Counts the conflicts of every row of a grid: for each cell, the other cells of its column and of its block
+ * holding the same digit.
+ * @param grid the 81 cells of the grid
+ * @param conflicts the conflicts of the 9 rows
+ */
+void sudoku_row_conflicts(const unsigned char *grid, unsigned int *conflicts){
 
-        unsigned int *row = get_row(sudoku, i);
+    unsigned char counts[18][10] = {{0}};
+
+    for(int i = 0; i < 81; i++){
 
-        for(int y = 0; y < 9; y++){
+        if (grid[i] - 1u < 9) {
 
-            printf("%d ", row[y]);
+            counts[cell_units[i][1]][grid[i]]++;
+            counts[9 + cell_units[i][2]][grid[i]]++;
 
         }
 
-        printf("\n");
+    }
+
+    for(int row = 0; row < 9; row++){
 
-    };
+        conflicts[row] = 0;
 
-    GeneticGenerator* gen = genetic_generator_create(81);
+        for(int i = row * 9; i < row * 9 + 9; i++){
 
+            if (grid[i] - 1u < 9) {
 
-    for(int i = 0; i < gen->size; i++){
+                conflicts[row] += counts[cell_units[i][1]][grid[i]] - 1u + counts[9 + cell_units[i][2]][grid[i]] - 1u;
 
-        genetic_generator_set_cardinality(gen, i, 9);
+            }
+
+        }
 
     }
 
-    float cross_over;
-    float mutation;
-    int individuals;
-    int generations;
+}
 
-    sscanf(argv[2], "%f", &cross_over);
-    sscanf(argv[3], "%f", &mutation);
-    sscanf(argv[4], "%d", &individuals);
-    sscanf(argv[5], "%d", &generations);
+/**
+ * Locates the free cells of every row of an encoded sudoku in its genomes.
+ * @param sudoku the encoded sudoku
+ * @param begins the locus of the first free cell of each row, followed by the size of the genome
+ */
+static void sudoku_row_loci(const Sudoku *sudoku, unsigned int *begins){
+
+    unsigned int locus = 0;
 
-    printf("Generating a population of %d individuals\n", individuals);
+    for(int row = 0; row < 9; row++){
 
-    Population *population = ga_population_create(gen, individuals);
+        begins[row] = locus;
 
-    printf("Evolving population with %f cross-over and %f mutation rates\n", cross_over, mutation);
+        for(int i = row * 9; i < row * 9 + 9; i++){
 
-    for(int i = 0; i < generations; i++){
+            locus += sudoku->loci[i] != SUDOKU_GIVEN;
 
-        population = ga_population_next(population, cross_over, mutation, fitness, sudoku);
+        }
 
     }
 
-    printf("Last best score : %d\n", get_best_score());
-    Individual *individual = get_best_individual();
+    begins[9] = locus;
 
-    for(int i = 0; i < 9; i++){
+}
 
-        unsigned int *row = get_row(individual->genome, i);
+/**
+ * Exchanges the free cells of a range of rows between two genomes.
+ * @param sister the first genome
+ * @param brother the second genome
+ * @param width the number of bytes of a chromosome
+ * @param begins the loci of the rows given by sudoku_row_loci
+ * @param first the first row
+ * @param last the row following the last one
+ */
+static void sudoku_exchange(unsigned char *sister, unsigned char *brother, unsigned int width,
+                            const unsigned int *begins, int first, int last){
 
-        printf("- [");
+    for(unsigned int i = begins[first] * width; i < begins[last] * width; i++){
 
-        for(int y = 0; y < 9; y++){
+        unsigned char byte = sister[i];
+        sister[i] = brother[i];
+        brother[i] = byte;
 
-            printf("%d", row[y]);
+    }
 
-            if (y != 8)
-                printf(", ");
+}
+
+/**
+ * Crosses two genomes of an encoded sudoku over by exchanging whole rows, each one with a probability, so that
+ * the rows keep their digits.
+ * @param generator the generator of the sudoku
+ * @param width the number of bytes of a chromosome
+ * @param sister the first child, a copy of the first parent
+ * @param brother the second child, a copy of the second parent
+ * @param rate the probability to exchange a row
+ * @param random the random generator
+ * @param problem the encoded sudoku
+ */
+void sudoku_cross_over_rows(const GeneticGenerator *generator, unsigned int width, void *sister, void *brother,
+                            float rate, Random *random, const void *problem){
+
+    unsigned int begins[10];
+    unsigned int skip = ga_random_geometric(random, rate);
+
+    (void)generator;
+    sudoku_row_loci(problem, begins);
+
+    for(int row = 0; row < 9; row++){
+
+        if (skip) {
+
+            skip--;
+
+        } else {
+
+            sudoku_exchange(sister, brother, width, begins, row, row + 1);
+            skip = ga_random_geometric(random, rate);
 
         }
 
-        printf("]\n");
+    }
 
-    };
+}
 
-    ga_population_destroy(population);
-    genetic_generator_destroy(gen);
+/**
+ * Crosses two genomes of an encoded sudoku over by exchanging whole bands of three rows, and so their blocks,
+ * each one with a probability.
+ * @param generator the generator of the sudoku
+ * @param width the number of bytes of a chromosome
+ * @param sister the first child, a copy of the first parent
+ * @param brother the second child, a copy of the second parent
+ * @param rate the probability to exchange a band
+ * @param random the random generator
+ * @param problem the encoded sudoku
+ */
+void sudoku_cross_over_bands(const GeneticGenerator *generator, unsigned int width, void *sister, void *brother,
+                             float rate, Random *random, const void *problem){
 
-    return 0;
+    unsigned int begins[10];
+    unsigned int draws[3];
+
+    (void)generator;
+    sudoku_row_loci(problem, begins);
+    ga_random_fill(random, draws, 3);
+
+    for(int band = 0; band < 3; band++){
+
+        if (draws[band] < (double) rate * 4294967296.0) {
+
+            sudoku_exchange(sister, brother, width, begins, 3 * band, 3 * band + 3);
+
+        }
+
+    }
+
+}
+
+/**
+ * Crosses two genomes of an encoded sudoku over guided by the conflicts of their rows: each row takes part with
+ * a probability, the sister receiving the one with the fewer conflicts in its parent and the brother one of both
+ * at random, so that the sister gathers the best rows of both parents while the brother keeps the diversity.
+ * @param generator the generator of the sudoku
+ * @param width the number of bytes of a chromosome
+ * @param sister the first child, a copy of the first parent
+ * @param brother the second child, a copy of the second parent
+ * @param rate the probability for a row to take part
+ * @param random the random generator
+ * @param problem the encoded sudoku
+ */
+void sudoku_cross_over_guided(const GeneticGenerator *generator, unsigned int width, void *sister, void *brother,
+                              float rate, Random *random, const void *problem){
 
-}
\ No newline at end of file
+    const Sudoku *sudoku = problem;
+    unsigned int begins[10];
+    unsigned int conflicts[2][9];
+    unsigned char grid[81];
+    unsigned int skip = ga_random_geometric(random, rate);
+
+    (void)generator;
+
+    if (skip >= 9) {
+
+        return;
+
+    }
+
+    sudoku_row_loci(sudoku, begins);
+    sudoku_decode(sudoku, sister, grid);
+    sudoku_row_conflicts(grid, conflicts[0]);
+    sudoku_decode(sudoku, brother, grid);
+    sudoku_row_conflicts(grid, conflicts[1]);
+
+    for(int row = 0; row < 9; row++){
+
+        if (skip) {
+
+            skip--;
+
+        } else {
+
+            bool better = conflicts[1][row] < conflicts[0][row];
+            bool drawn = ga_random_next(random) >> 63;
+            size_t begin = begins[row] * width;
+            size_t length = (begins[row + 1] - begins[row]) * width;
+
+            /* the sister takes the better row and the brother the row of the drawn parent */
+            if (better && !drawn) {
+
+                sudoku_exchange(sister, brother, width, begins, row, row + 1);
+
+            } else if (better) {
+
+                memcpy((unsigned char *)sister + begin, (unsigned char *)brother + begin, length);
+
+            } else if (!drawn) {
+
+                memcpy((unsigned char *)brother + begin, (unsigned char *)sister + begin, length);
+
+            }
+
+            skip = ga_random_geometric(random, rate);
+
+        }
+
+    }
+
+}
@@ -5,4 +5,80 @@
 #ifndef GENETIC_ALGORITHM_SUDOKU_H
 #define GENETIC_ALGORITHM_SUDOKU_H
 
+#include "ga.h"
+
+extern unsigned int *get_row(const unsigned int *sd, int row_number);
+extern unsigned int *get_column(const unsigned int *sd, int col_number);
+extern unsigned int *get_block(const unsigned int *sd, int block_number);
+extern int count_occurrences(const unsigned int *sd, int n, int x);
+/**
+ * Beyond this number of changed cells, rating the whole sudoku is cheaper than rating the affected units.
+ */
+#define SUDOKU_DELTA_LIMIT 3
+
+extern unsigned int fitness(const void *genome, const void *problem);
+extern void fitness_batch(const void *const *genomes, unsigned int count, unsigned int *notes, const void *problem);
+extern unsigned int fitness_delta(const void *parent_genome, unsigned int note, const void *genome,
+                                  const unsigned int *changes, unsigned int count, const void *problem);
+
+/**
+ * The locus of a given cell, which is not part of the genome.
+ */
+#define SUDOKU_GIVEN 255
+
+/**
+ * A sudoku encoded for the genetic algorithm: the genome only holds the free cells, row by row, and every row
+ * is a permutation segment of the digits missing from its givens. The free cells may only take the candidates
+ * left by the givens of their row, column and block.
+ */
+typedef struct {
+    unsigned int givens[81];
+    unsigned short candidates[81];
+    unsigned int size;
+    unsigned char cells[81];
+    unsigned char loci[81];
+} Sudoku;
+
+extern Sudoku *sudoku_create(const unsigned int *givens);
+extern void sudoku_destroy(Sudoku *sudoku);
+extern GeneticGenerator *sudoku_generator(const Sudoku *sudoku);
+extern void sudoku_decode(const Sudoku *sudoku, const void *genome, unsigned char *grid);
+
+extern unsigned int sudoku_fitness(const void *genome, const void *problem);
+extern void sudoku_fitness_batch(const void *const *genomes, unsigned int count, unsigned int *notes,
+                                 const void *problem);
+extern unsigned int sudoku_fitness_delta(const void *parent_genome, unsigned int note, const void *genome,
+                                         const unsigned int *changes, unsigned int count, const void *problem);
+
+/**
+ * The maximum number of passes of the hill climber over the rows of a sudoku.
+ */
+#define SUDOKU_CLIMB_PASSES 4
+
+/**
+ * The fraction of the best individuals of each generation improved by the hill climber in the sudoku binary.
+ */
+#define SUDOKU_LOCAL_SEARCH_FRACTION 0.05f
+
+/**
+ * The number of ratings remembered by each solver of the sudoku binary, children bred by the row cross-overs
+ * often being copies of rated individuals.
+ */
+#define SUDOKU_CACHE_CAPACITY (1U << 16)
+
+/**
+ * The number of generations between two progress reports of the sudoku binary.
+ */
+#define SUDOKU_REPORT_INTERVAL 10
+
+extern unsigned int sudoku_local_search(void *genome, unsigned int note, const void *problem, Random *random);
+
+extern void sudoku_row_conflicts(const unsigned char *grid, unsigned int *conflicts);
+extern void sudoku_cross_over_rows(const GeneticGenerator *generator, unsigned int width, void *sister, void *brother,
+                                   float rate, Random *random, const void *problem);
+extern void sudoku_cross_over_bands(const GeneticGenerator *generator, unsigned int width, void *sister,
+                                    void *brother, float rate, Random *random, const void *problem);
+extern void sudoku_cross_over_guided(const GeneticGenerator *generator, unsigned int width, void *sister,
+                                     void *brother, float rate, Random *random, const void *problem);
+
 #endif //GENETIC_ALGORITHM_SUDOKU_H
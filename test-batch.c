@@ -0,0 +1,79 @@
+/**
+ * @file test-batch.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./batch.h"
+
+int main(void) {
+  ga_init();
+  {
+    FILE *stream = tmpfile();
+    unsigned int count;
+    assert(stream != NULL);
+    fputs("# a comment\n\n", stream);
+    fputs("..6......8..542....4..9..7...79..3......8.4..6.....1..2.3.67981...5...4.478319562\n", stream);
+    fputs("12345\n", stream);
+    /* a long comment is skipped as a whole, none of its cells is read */
+    fprintf(stream, "#%300s", "");
+    fputs("..6......8..542....4..9..7...79..3......8.4..6.....1..2.3.67981...5...4.478319562\n", stream);
+    /* solved grids missing one cell */
+    for (unsigned int puzzle = 0; puzzle < 6; puzzle++) {
+      for (unsigned int cell = 0; cell < 81; cell++) {
+        unsigned int row = cell / 9;
+        fputc(cell == puzzle * 13 ? '0' : (char)('1' + (row * 3 + row / 3 + cell % 9) % 9), stream);
+      }
+      fputc('\n', stream);
+    }
+    rewind(stream);
+    unsigned int *puzzles = sudoku_batch_read(stream, &count);
+    fclose(stream);
+    assert(count == 7);
+    assert(puzzles[0] == 0 && puzzles[2] == 6 && puzzles[80] == 2);
+    assert(puzzles[81] == 0 && puzzles[82] == 2);
+
+    BatchSettings settings = {.cross_over = 0.5f, .mutation = 0.01f, .individuals = 20, .generations = 5,
+                              .workers = 1, .seed = 3};
+    BatchResult serial[7];
+    BatchResult parallel[7];
+    assert(sudoku_batch_solve(puzzles, count, &settings, serial, NULL));
+    settings.workers = 3;
+    assert(sudoku_batch_solve(puzzles, count, &settings, parallel, NULL));
+    for (unsigned int i = 0; i < count; i++) {
+      assert(serial[i].score == parallel[i].score);
+      assert(serial[i].generations == parallel[i].generations);
+      assert(serial[i].generations >= 1 && serial[i].generations <= 5);
+    }
+    assert(serial[0].score > 0 && serial[0].generations == 5);
+
+    /* percentiles by nearest rank, as in the summary */
+    BatchResult timed[10];
+    for (unsigned int i = 0; i < 10; i++) {
+      timed[i].elapsed = (double)((i * 7) % 10 + 1);
+    }
+    double *durations = sudoku_batch_durations(timed, 10);
+    assert(durations != NULL && durations[0] == 1.0 && durations[9] == 10.0);
+    assert(sudoku_batch_percentile(durations, 10, 500) == 5.0);
+    assert(sudoku_batch_percentile(durations, 10, 900) == 9.0);
+    assert(sudoku_batch_percentile(durations, 10, 990) == 10.0);
+    assert(sudoku_batch_percentile(durations, 10, 0) == 1.0);
+    assert(sudoku_batch_percentile(durations, 0, 500) == 0.0);
+    free(durations);
+
+    free(puzzles);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file test-cache.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+
+static unsigned int calls = 0;
+
+static unsigned int evaluate(const void *genome, const void *problem) {
+  const unsigned short *chromosomes = genome;
+  const unsigned int *size = problem;
+  unsigned int note = 0;
+  calls++;
+  for (unsigned int index = 0; index < *size; index++) {
+    note += chromosomes[index];
+  }
+  return note;
+}
+
+static Population *run(Solver *solver, const GeneticGenerator *generator, unsigned int *size) {
+  Population *population = ga_population_create(solver, generator, 40);
+  for (unsigned int generation = 0; generation < 50; generation++) {
+    population = ga_population_next(solver, population, 0.3f, 0.01f, evaluate, size);
+  }
+  return population;
+}
+
+int main(void) {
+  ga_init();
+  {
+    /* chromosomes of two bytes */
+    unsigned int size = 30;
+    GeneticGenerator *generator = genetic_generator_create(size);
+    for (unsigned int index = 0; index < size; index++) {
+      genetic_generator_set_cardinality(generator, index, 300);
+    }
+
+    Solver *plain = ga_solver_create(5);
+    ga_solver_set_verbose(plain, false);
+    ga_solver_set_elitism(plain, 2);
+    Population *expected = run(plain, generator, &size);
+    unsigned int plain_calls = calls;
+    assert(ga_solver_get_cache_lookups(plain) == 0);
+
+    /* a cached run is the same run with fewer evaluations */
+    calls = 0;
+    Solver *cached = ga_solver_create(5);
+    ga_solver_set_verbose(cached, false);
+    ga_solver_set_elitism(cached, 2);
+    assert(ga_solver_set_cache(cached, 1000) == cached);
+    assert(cached->cache->mask == 1023);
+    Population *population = run(cached, generator, &size);
+    assert(!memcmp(population->genomes, expected->genomes, population->size * population->row));
+    assert(get_best_score(cached) == get_best_score(plain));
+    assert(ga_solver_get_cache_lookups(cached) == ga_solver_get_evaluations(plain));
+    assert(ga_solver_get_cache_hits(cached) > 0);
+    assert(ga_solver_get_evaluations(cached) + ga_solver_get_cache_hits(cached) == ga_solver_get_evaluations(plain));
+    assert(calls == ga_solver_get_evaluations(cached) && calls < plain_calls);
+
+    /* the hashes follow the genomes */
+    for (unsigned int i = 0; i < population->size; i++) {
+      uint64_t hash = population->hashes[i];
+      Population *single = ga_population_clone(population);
+      ga_solver_reset(cached, 9, i);
+      ga_population_next(cached, single, 0, 0, evaluate, &size);
+      assert(single->back_hashes[i] == hash);
+      ga_population_destroy(single);
+    }
+
+    /* a reset empties the cache */
+    ga_solver_reset(cached, 5, 0);
+    assert(ga_solver_get_cache_lookups(cached) == 0 && ga_solver_get_cache_hits(cached) == 0);
+    assert(ga_solver_set_cache(cached, 0) == cached && !cached->cache);
+
+    ga_population_destroy(population);
+    ga_population_destroy(expected);
+    ga_solver_destroy(cached);
+    ga_solver_destroy(plain);
+    genetic_generator_destroy(generator);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
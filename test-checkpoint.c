@@ -0,0 +1,149 @@
+/**
+ * @file test-checkpoint.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+
+static unsigned int evaluate(const void *genome, const void *problem) {
+  const unsigned char *chromosomes = genome;
+  const unsigned int *size = problem;
+  unsigned int note = 0;
+  for (unsigned int index = 0; index < *size; index++) {
+    note += chromosomes[index];
+  }
+  return note;
+}
+
+static Solver *create(void) {
+  Solver *solver = ga_solver_create(7);
+  ga_solver_set_verbose(solver, false);
+  ga_solver_set_elitism(solver, 2);
+  return solver;
+}
+
+static FILE *checkpoint(const Solver *solver, const Population *population) {
+  FILE *stream = tmpfile();
+  assert(ga_checkpoint_fwrite(solver, population, stream) == population);
+  rewind(stream);
+  return stream;
+}
+
+static void corrupt(FILE *stream, long offset, int delta) {
+  int byte;
+  assert(!fseek(stream, offset, SEEK_SET));
+  byte = fgetc(stream);
+  assert(!fseek(stream, offset, SEEK_SET));
+  fputc(byte + delta, stream);
+  rewind(stream);
+}
+
+int main(void) {
+  ga_init();
+  {
+    unsigned int size = 40;
+    GeneticGenerator *generator = genetic_generator_create(size);
+    for (unsigned int index = 0; index < size; index++) {
+      genetic_generator_set_cardinality(generator, index, 9);
+    }
+
+    Solver *solver = create();
+    Population *population = ga_population_create(solver, generator, 30);
+    for (unsigned int generation = 0; generation < 10; generation++) {
+      population = ga_population_next(solver, population, 0.5f, 0.1f, evaluate, &size);
+    }
+    FILE *stream = checkpoint(solver, population);
+
+    /* the genome matrix starts on a page boundary */
+    uint64_t offset;
+    assert(!fseek(stream, 8 * sizeof(uint32_t) + 2 * sizeof(uint64_t), SEEK_SET));
+    assert(fread(&offset, sizeof(offset), 1, stream) == 1);
+    assert(offset % 4096 == 0);
+    rewind(stream);
+
+    /* a resumed run is the same as an uninterrupted one */
+    Solver *resumed = create();
+    Population *copy = ga_checkpoint_fread(resumed, stream);
+    assert(copy);
+    assert(copy->size == population->size && copy->stride == population->stride);
+    assert(ga_solver_get_generation(resumed) == ga_solver_get_generation(solver));
+    assert(get_best_score(resumed) == get_best_score(solver));
+    assert(ga_solver_get_evaluations(resumed) == ga_solver_get_evaluations(solver));
+    assert(!memcmp(copy->genomes, population->genomes, population->size * population->row));
+    for (unsigned int generation = 0; generation < 10; generation++) {
+      population = ga_population_next(solver, population, 0.5f, 0.1f, evaluate, &size);
+      copy = ga_population_next(resumed, copy, 0.5f, 0.1f, evaluate, &size);
+    }
+    assert(get_best_score(resumed) == get_best_score(solver));
+    assert(!memcmp(get_best_individual(resumed)->genome, get_best_individual(solver)->genome, size));
+    assert(!memcmp(copy->genomes, population->genomes, population->size * population->row));
+    ga_population_destroy(copy);
+
+    /* a corrupted or foreign checkpoint is rejected and leaves the solver untouched */
+    Solver *other = create();
+    corrupt(stream, offset + 5, 1);
+    assert(!ga_checkpoint_fread(other, stream));
+    corrupt(stream, offset + 5, -1);
+    corrupt(stream, sizeof(uint32_t), 1);
+    assert(!ga_checkpoint_fread(other, stream));
+    assert(ga_solver_get_generation(other) == 1);
+    assert(!get_best_individual(other));
+    corrupt(stream, sizeof(uint32_t), -1);
+    /* a header whose population or genome sizes do not fit its generator is rejected */
+    corrupt(stream, 3 * sizeof(uint32_t), 1);
+    assert(!ga_checkpoint_fread(other, stream));
+    corrupt(stream, 3 * sizeof(uint32_t), -1);
+    corrupt(stream, 4 * sizeof(uint32_t), 1);
+    assert(!ga_checkpoint_fread(other, stream));
+    corrupt(stream, 4 * sizeof(uint32_t), -1);
+    corrupt(stream, 5 * sizeof(uint32_t), 2);
+    assert(!ga_checkpoint_fread(other, stream));
+    corrupt(stream, 5 * sizeof(uint32_t), -2);
+
+    /* the cache and the statistics of a previous run are forgotten */
+    ga_solver_set_cache(other, 64);
+#if GA_INSTRUMENTATION
+    ga_solver_set_instrumentation(other, 4);
+#endif
+    Population *previous = ga_population_create(other, generator, 30);
+    for (unsigned int generation = 0; generation < 3; generation++) {
+      previous = ga_population_next(other, previous, 0.5f, 0.1f, evaluate, &size);
+    }
+    ga_population_destroy(previous);
+    assert(ga_solver_get_cache_lookups(other) > 0);
+#if GA_INSTRUMENTATION
+    assert(ga_solver_get_total_statistics(other)->generation == 3);
+#endif
+    copy = ga_checkpoint_fread(other, stream);
+    assert(copy);
+    assert(ga_solver_get_cache_lookups(other) == 0 && ga_solver_get_cache_hits(other) == 0);
+#if GA_INSTRUMENTATION
+    assert(ga_solver_get_total_statistics(other)->generation == 0);
+#endif
+    assert(ga_solver_get_generation(other) == ga_solver_get_generation(resumed) - 10);
+    ga_population_destroy(copy);
+
+    fclose(stream);
+    ga_solver_destroy(other);
+    ga_solver_destroy(resumed);
+    ga_solver_destroy(solver);
+    ga_population_destroy(population);
+    genetic_generator_destroy(generator);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
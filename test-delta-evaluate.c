@@ -0,0 +1,90 @@
+/**
+ * @file test-delta-evaluate.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+
+static unsigned int full = 0;
+static unsigned int incremental = 0;
+
+static unsigned int evaluate(const void *genome, const void *problem) {
+  const unsigned char *chromosomes = genome;
+  const unsigned int *size = problem;
+  unsigned int note = 0;
+  full++;
+  for (unsigned int index = 0; index < *size; index++) {
+    note += chromosomes[index] * (index % 3);
+  }
+  return note;
+}
+
+static unsigned int evaluate_delta(const void *parent_genome, unsigned int note, const void *child_genome,
+                                   const unsigned int *changes, unsigned int count, const void *problem) {
+  const unsigned char *parent = parent_genome;
+  const unsigned char *child = child_genome;
+  (void)problem;
+  incremental++;
+  for (unsigned int i = 0; i < count; i++) {
+    assert(parent[changes[i]] != child[changes[i]]);
+    note += (child[changes[i]] - parent[changes[i]]) * (changes[i] % 3);
+  }
+  return note;
+}
+
+static Population *run(Solver *solver, const GeneticGenerator *generator, const unsigned int *size) {
+  Population *population = ga_population_create(solver, generator, 40);
+  for (unsigned int generation = 0; generation < 15; generation++) {
+    population = ga_population_next(solver, population, 0.05f, 0.02f, evaluate, size);
+  }
+  return population;
+}
+
+int main(void) {
+  ga_init();
+  {
+    unsigned int size = 40;
+    GeneticGenerator *generator = genetic_generator_create(size);
+    for (unsigned int index = 0; index < size; index++) {
+      genetic_generator_set_cardinality(generator, index, 9);
+    }
+
+    Solver *solver = ga_solver_create(7);
+    Population *scratch = run(solver, generator, &size);
+    unsigned int scratch_evaluations = full;
+    ga_solver_destroy(solver);
+    full = 0;
+    solver = ga_solver_create(7);
+    assert(ga_solver_set_delta_evaluate(solver, evaluate_delta, 10) == solver);
+    Population *delta = run(solver, generator, &size);
+    assert(memcmp(scratch->genomes, delta->genomes, 40 * size) == 0);
+    for (unsigned int i = 0; i < 40; i++) {
+      assert(scratch->ranks[i].note == delta->ranks[i].note);
+    }
+    assert(incremental > 0);
+    assert(full + incremental == scratch_evaluations);
+
+    assert(ga_solver_set_delta_evaluate(solver, NULL, 10) == solver);
+    ga_population_next(solver, delta, 0.05f, 0.02f, evaluate, &size);
+    assert(!delta->lineages_valid);
+    ga_solver_destroy(solver);
+
+    ga_population_destroy(delta);
+    ga_population_destroy(scratch);
+    genetic_generator_destroy(generator);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file test-elitism.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+
+static unsigned int calls;
+
+static unsigned int evaluate(const void *genome, const void *problem) {
+  const unsigned char *chromosomes = genome;
+  const unsigned int *size = problem;
+  unsigned int note = 0;
+  __atomic_add_fetch(&calls, 1, __ATOMIC_RELAXED);
+  for (unsigned int index = 0; index < *size; index++) {
+    note += chromosomes[index];
+  }
+  return note;
+}
+
+static int compare(const void *first, const void *second) {
+  unsigned int a = *(const unsigned int *)first;
+  unsigned int b = *(const unsigned int *)second;
+  return (a > b) - (a < b);
+}
+
+static unsigned int best_note(const Population *population) {
+  unsigned int best = population->ranks[0].note;
+  for (unsigned int i = 1; i < population->size; i++) {
+    if (population->ranks[i].note < best) {
+      best = population->ranks[i].note;
+    }
+  }
+  return best;
+}
+
+int main(void) {
+  ga_init();
+  {
+    unsigned int size = 20;
+    GeneticGenerator *generator = genetic_generator_create(size);
+    for (unsigned int index = 0; index < size; index++) {
+      genetic_generator_set_cardinality(generator, index, 9);
+    }
+
+    /* the elites are carried with their ratings, so only the children are evaluated */
+    Solver *solver = ga_solver_create(9);
+    ga_solver_set_verbose(solver, false);
+    assert(ga_solver_set_elitism(solver, 3) == solver);
+    Population *population = ga_population_create(solver, generator, 30);
+    ga_population_next(solver, population, 0.5f, 0.2f, evaluate, &size);
+    assert(population->survivors == 4);
+    for (unsigned int i = 0; i < population->survivors; i++) {
+      assert(population->notes[i] == evaluate(population->individuals[i].genome, &size));
+    }
+    unsigned int best = get_best_score(solver);
+    calls = 0;
+    ga_population_next(solver, population, 0.5f, 0.2f, evaluate, &size);
+    assert(calls == 26);
+    assert(ga_solver_get_evaluations(solver) == 56);
+    assert(best_note(population) == best);
+    for (unsigned int generation = 0; generation < 20; generation++) {
+      ga_population_next(solver, population, 0.5f, 0.2f, evaluate, &size);
+      assert(best_note(population) <= best);
+      best = best_note(population);
+    }
+    ga_population_destroy(population);
+
+    /* a steady state replaces the worst individuals only */
+    assert(ga_solver_set_elitism(solver, 0) == solver);
+    assert(ga_solver_set_steady_state(solver, 0.2f) == solver);
+    population = ga_population_create(solver, generator, 30);
+    ga_population_next(solver, population, 0.5f, 0.2f, evaluate, &size);
+    assert(population->survivors == 24);
+    calls = 0;
+    ga_population_next(solver, population, 0.5f, 0.2f, evaluate, &size);
+    assert(calls == 6);
+    unsigned int notes[30];
+    unsigned long long kept = 0;
+    unsigned long long smallest = 0;
+    for (unsigned int i = 0; i < 30; i++) {
+      notes[i] = evaluate(population->individuals[i].genome, &size);
+    }
+    qsort(notes, 30, sizeof(unsigned int), compare);
+    ga_population_next(solver, population, 0.5f, 0.2f, evaluate, &size);
+    for (unsigned int i = 0; i < population->survivors; i++) {
+      kept += population->notes[i];
+      smallest += notes[i];
+    }
+    assert(kept == smallest);
+    ga_population_destroy(population);
+
+    /* a generational replacement evaluates everything */
+    assert(ga_solver_set_steady_state(solver, 1.0f) == solver);
+    population = ga_population_create(solver, generator, 30);
+    ga_population_next(solver, population, 0.5f, 0.2f, evaluate, &size);
+    assert(population->survivors == 0);
+    ga_population_destroy(population);
+
+    ga_solver_destroy(solver);
+    genetic_generator_destroy(generator);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
@@ -33,10 +33,75 @@ int main(void) {
     }
     fclose(stream);
 
+    /* the permutation segments are written behind the cardinalities */
+    const unsigned int values[3] = {4, 1, 2};
+    assert(genetic_generator_set_segment(generator, 6, 3, values) == generator);
+    assert(genetic_generator_set_domain(generator, 3, values, 2) == generator);
+    stream = tmpfile();
+    assert(genetic_generator_fwrite(generator, stream) == generator);
+    rewind(stream);
+    assert(genetic_generator_fread(read, stream) == read);
+    assert(genetic_generator_get_segment(read, 6) == 3);
+    assert(genetic_generator_get_segment(read, 7) == 0);
+    assert(genetic_generator_get_cardinality(read, 6) == 4);
+    unsigned int count;
+    assert(genetic_generator_get_domain(read, 3, &count)[1] == 1 && count == 2);
+    genetic_generator_get_domain(read, 4, &count);
+    assert(count == 0);
+    fclose(stream);
+
+    /* cleared domains have no values to write, read or copy */
+    assert(genetic_generator_set_domain(generator, 3, NULL, 0) == generator);
+    stream = tmpfile();
+    assert(genetic_generator_fwrite(generator, stream) == generator);
+    rewind(stream);
+    assert(genetic_generator_fread(read, stream) == read);
+    genetic_generator_get_domain(read, 3, &count);
+    assert(count == 0);
+    assert(genetic_generator_copy(read, generator) == read);
+    genetic_generator_get_domain(read, 3, &count);
+    assert(count == 0);
+    fclose(stream);
+
     stream = tmpfile();
     assert(genetic_generator_fread(read, stream) == NULL);
     fclose(stream);
 
+    /* a file without magic word only holds the size and the cardinalities */
+    const unsigned int legacy[4] = {3, 2, 4, 6};
+    stream = tmpfile();
+    fwrite(legacy, sizeof(unsigned int), 4, stream);
+    rewind(stream);
+    assert(genetic_generator_fread(read, stream) == read);
+    assert(genetic_generator_get_size(read) == 3 && genetic_generator_get_cardinality(read, 2) == 6);
+    assert(genetic_generator_get_segment(read, 0) == 0);
+    fclose(stream);
+
+    /* the version, the segments and the domains are checked */
+    const unsigned int invalid[][14] = {
+      {0x4E474147u, GA_GENERATOR_VERSION + 1, 3, 3, 3, 3, 0, 0},
+      {0x4E474147u, GA_GENERATOR_VERSION, 3, 3, 3, 3, 2, 0},
+      {0x4E474147u, GA_GENERATOR_VERSION, 3, 3, 3, 3, 1, 2, 0, 0, 1, 0, 0, 0},
+      {0x4E474147u, GA_GENERATOR_VERSION, 3, 3, 3, 3, 1, 2, 2, 0, 1, 2, 3, 0},
+      {0x4E474147u, GA_GENERATOR_VERSION, 3, 3, 3, 3, 1, 0, 0, 3, 0, 0, 1, 0},
+      {0x4E474147u, GA_GENERATOR_VERSION, 3, 3, 3, 3, 0, 1, 0, 1, 1, 1, 0, 0},
+      {0x4E474147u, GA_GENERATOR_VERSION, 3, 3, 3, 3, 0, 1, 0, 1, 1, 1, 4, 0},
+    };
+    for (unsigned int i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+      stream = tmpfile();
+      fwrite(invalid[i], sizeof(unsigned int), 14, stream);
+      rewind(stream);
+      assert(genetic_generator_fread(read, stream) == NULL);
+      fclose(stream);
+    }
+    const unsigned int valid[14] = {0x4E474147u, GA_GENERATOR_VERSION, 3, 3, 3, 3, 1, 2, 0, 0, 1, 2, 0, 0};
+    stream = tmpfile();
+    fwrite(valid, sizeof(unsigned int), 14, stream);
+    rewind(stream);
+    assert(genetic_generator_fread(read, stream) == read);
+    assert(genetic_generator_get_segment(read, 0) == 2);
+    fclose(stream);
+
     genetic_generator_destroy(generator);
     genetic_generator_destroy(read);
   }
@@ -0,0 +1,72 @@
+/**
+ * @file test-fortune-wheel.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+
+int main(void) {
+  ga_init();
+  {
+    Random *random = ga_random_default();
+    Individual individuals[4];
+    Fortune_Rank ranks[4];
+    unsigned int notes[4] = {0, 10, 30, 60};
+    unsigned int hits[4] = {0, 0, 0, 0};
+    unsigned long long sum_of_fitness = 0;
+    for (unsigned int i = 0; i < 4; i++) {
+      individuals[i].index = i;
+      ranks[i].individual = &individuals[i];
+      ranks[i].note = notes[i];
+      sum_of_fitness += notes[i];
+    }
+    double total = ga_fortune_wheel_build(ranks, 4, sum_of_fitness);
+    assert(total == ranks[3].wheel);
+    for (unsigned int i = 1; i < 4; i++) {
+      assert(ranks[i].wheel >= ranks[i - 1].wheel);
+    }
+    for (unsigned int draw = 0; draw < 30000; draw++) {
+      hits[get_random_individual(random, ranks, 4)->index]++;
+    }
+    /* weights are 1, 0.9, 0.7 and 0.4 */
+    assert(hits[0] > hits[1] && hits[1] > hits[2] && hits[2] > hits[3]);
+    assert(hits[3] > 0);
+
+    /* an individual holding all the fitness is never selected */
+    ranks[0].note = 0;
+    ranks[1].note = 0;
+    ranks[2].note = 0;
+    ranks[3].note = 100;
+    ga_fortune_wheel_build(ranks, 4, 100);
+    for (unsigned int draw = 0; draw < 1000; draw++) {
+      assert(get_random_individual(random, ranks, 4)->index != 3);
+    }
+
+    /* the sum of fitness does not overflow 32 bits */
+    for (unsigned int i = 0; i < 4; i++) {
+      ranks[i].note = UINT_MAX - i;
+    }
+    ga_fortune_wheel_build(ranks, 4, 4ULL * UINT_MAX - 6);
+    assert(ranks[3].wheel > 11.9 && ranks[3].wheel < 12.1);
+
+    /* a perfect generation gives a uniform wheel */
+    for (unsigned int i = 0; i < 4; i++) {
+      ranks[i].note = 0;
+    }
+    assert(ga_fortune_wheel_build(ranks, 4, 0) == 4);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file test-instrumentation.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+
+static unsigned int evaluate(const void *genome, const void *problem) {
+  const unsigned char *chromosomes = genome;
+  const unsigned int *size = problem;
+  unsigned int note = 0;
+  for (unsigned int index = 0; index < *size; index++) {
+    note += chromosomes[index];
+  }
+  return note;
+}
+
+static unsigned int allocating_search(void *genome, unsigned int note, const void *problem, Random *random) {
+  (void)genome;
+  (void)problem;
+  (void)random;
+  ga_free(ga_malloc(100));
+  return note;
+}
+
+static unsigned int count_lines(FILE *stream) {
+  unsigned int lines = 0;
+  int character;
+  rewind(stream);
+  while ((character = fgetc(stream)) != EOF) {
+    lines += character == '\n';
+  }
+  return lines;
+}
+
+int main(void) {
+  ga_init();
+  {
+    unsigned int size = 20;
+    GeneticGenerator *generator = genetic_generator_create(size);
+    for (unsigned int index = 0; index < size; index++) {
+      genetic_generator_set_cardinality(generator, index, 9);
+    }
+    Solver *solver = ga_solver_create(3);
+    ga_solver_set_verbose(solver, false);
+    ga_solver_set_elitism(solver, 2);
+    Population *population = ga_population_create(solver, generator, 30);
+    assert(!ga_solver_get_total_statistics(solver));
+    assert(!ga_solver_statistics_fwrite(solver, stdout, GA_STATISTICS_CSV));
+
+#if GA_INSTRUMENTATION
+    assert(ga_solver_set_instrumentation(solver, 5) == solver);
+    for (unsigned int generation = 0; generation < 8; generation++) {
+      population = ga_population_next(solver, population, 0.5f, 0.1f, evaluate, &size);
+    }
+
+    /* the history keeps the last generations */
+    assert(ga_solver_get_statistics(solver, 0)->generation == 8);
+    assert(ga_solver_get_statistics(solver, 4)->generation == 4);
+    assert(!ga_solver_get_statistics(solver, 5));
+    const GenerationStatistics *total = ga_solver_get_total_statistics(solver);
+    assert(total->generation == 8);
+    assert(total->evaluations == ga_solver_get_evaluations(solver));
+    assert(total->best == get_best_score(solver));
+    assert(total->best <= total->mean && total->mean <= total->worst);
+    for (unsigned int age = 0; age < 5; age++) {
+      const GenerationStatistics *statistics = ga_solver_get_statistics(solver, age);
+      assert(statistics->evaluations == 28);
+      assert(statistics->best <= statistics->mean && statistics->mean <= statistics->worst);
+      assert(statistics->allocations == 0);
+      for (unsigned int phase = 0; phase < GA_PHASES; phase++) {
+        assert(statistics->phases[phase] >= 0);
+      }
+      assert(statistics->phases[GA_PHASE_LOCAL_SEARCH] == 0);
+    }
+    /* the best individual and the elites are allocated on the first generation */
+    assert(total->allocations > 0 && total->bytes > 0);
+
+    /* dumps */
+    FILE *stream = tmpfile();
+    assert(ga_solver_statistics_fwrite(solver, stream, GA_STATISTICS_CSV));
+    assert(count_lines(stream) == 6);
+    rewind(stream);
+    char header[256];
+    assert(fgets(header, sizeof(header), stream));
+    assert(!strncmp(header, "generation,evaluation,local_search,", 35));
+    fclose(stream);
+    stream = tmpfile();
+    assert(ga_solver_statistics_fwrite(solver, stream, GA_STATISTICS_JSON));
+    assert(count_lines(stream) == 7);
+    rewind(stream);
+    assert(fgets(header, sizeof(header), stream));
+    assert(!strcmp(header, "{\"generations\": [\n"));
+    fclose(stream);
+
+    /* a reset forgets the statistics */
+    ga_solver_reset(solver, 3, 0);
+    assert(ga_solver_get_total_statistics(solver)->generation == 0);
+    assert(!ga_solver_get_statistics(solver, 0));
+    assert(ga_solver_set_instrumentation(solver, 0) == solver);
+    assert(!ga_solver_get_total_statistics(solver));
+
+    /* the allocations of the threads of the pool are counted too */
+    Solver *parallel = ga_solver_create(4);
+    ga_solver_set_threads(parallel, 4);
+    ga_solver_set_local_search(parallel, allocating_search, 0.5f, GA_LOCAL_SEARCH_RANDOM);
+    ga_solver_set_instrumentation(parallel, 3);
+    Population *other = ga_population_create(parallel, generator, 40);
+    for (unsigned int generation = 0; generation < 5; generation++) {
+      other = ga_population_next(parallel, other, 0.5f, 0.1f, evaluate, &size);
+    }
+    for (unsigned int age = 0; age < 3; age++) {
+      assert(ga_solver_get_statistics(parallel, age)->allocations == 20);
+      assert(ga_solver_get_statistics(parallel, age)->bytes == 2000);
+    }
+    ga_population_destroy(other);
+    ga_solver_destroy(parallel);
+#else
+    assert(!ga_solver_set_instrumentation(solver, 5));
+#endif
+
+    ga_population_destroy(population);
+    ga_solver_destroy(solver);
+    genetic_generator_destroy(generator);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file test-islands.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+
+static unsigned int evaluate(const void *genome, const void *problem) {
+  const unsigned char *chromosomes = genome;
+  const unsigned int *size = problem;
+  unsigned int note = 0;
+  for (unsigned int index = 0; index < *size; index++) {
+    note += (chromosomes[index] * (index + 1)) % 7;
+  }
+  return note;
+}
+
+static bool contains(const Population *population, const unsigned char *genome) {
+  for (unsigned int i = 0; i < population->size; i++) {
+    if (memcmp(population->individuals[i].genome, genome, population->row) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int main(void) {
+  ga_init();
+  {
+    unsigned int size = 30;
+    GeneticGenerator *generator = genetic_generator_create(size);
+    for (unsigned int index = 0; index < size; index++) {
+      genetic_generator_set_cardinality(generator, index, 9);
+    }
+
+    assert(ga_islands_create(generator, 0, 20, 1) == NULL);
+
+    /* without variation, the children are copies and the best parent of a ring predecessor arrives */
+    Islands *islands = ga_islands_create(generator, 3, 20, 5);
+    assert(islands != NULL);
+    assert(ga_islands_get_count(islands) == 3);
+    assert(memcmp(ga_islands_get_population(islands, 0)->genomes, ga_islands_get_population(islands, 1)->genomes,
+                  20 * size) != 0);
+    assert(ga_islands_set_migration(islands, 1, 1, GA_TOPOLOGY_RING) == islands);
+    assert(ga_islands_evolve(islands, 1, 0.0f, 0.0f, evaluate, &size) == islands);
+    for (unsigned int i = 0; i < 3; i++) {
+      const Solver *predecessor = ga_islands_get_solver(islands, (i + 2) % 3);
+      assert(ga_solver_get_generation(ga_islands_get_solver(islands, i)) == 2);
+      assert(contains(ga_islands_get_population(islands, i), get_best_individual(predecessor)->genome));
+    }
+    /* without migrants, the islands are isolated */
+    assert(ga_islands_set_migration(islands, 1, 0, GA_TOPOLOGY_RING) == islands);
+    assert(ga_islands_evolve(islands, 1, 0.0f, 0.0f, evaluate, &size) == islands);
+    ga_islands_destroy(islands);
+
+    /* a run only depends on its seed */
+    Islands *first = ga_islands_create(generator, 4, 32, 11);
+    Islands *second = ga_islands_create(generator, 4, 32, 11);
+    assert(ga_islands_set_migration(first, 3, 2, GA_TOPOLOGY_RANDOM) == first);
+    assert(ga_islands_set_migration(second, 3, 2, GA_TOPOLOGY_RANDOM) == second);
+    assert(ga_islands_evolve(first, 20, 0.5f, 0.05f, evaluate, &size) == first);
+    assert(ga_islands_evolve(second, 20, 0.5f, 0.05f, evaluate, &size) == second);
+    for (unsigned int i = 0; i < 4; i++) {
+      assert(memcmp(ga_islands_get_population(first, i)->genomes, ga_islands_get_population(second, i)->genomes,
+                    32 * size) == 0);
+      assert(get_best_score(ga_islands_get_best(first)) <= get_best_score(ga_islands_get_solver(first, i)));
+    }
+    assert(get_best_score(ga_islands_get_best(first)) == get_best_score(ga_islands_get_best(second)));
+    ga_islands_destroy(second);
+    ga_islands_destroy(first);
+
+    genetic_generator_destroy(generator);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
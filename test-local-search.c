@@ -0,0 +1,135 @@
+/**
+ * @file test-local-search.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+#include "./sudoku.h"
+
+static unsigned int searched = 0;
+static unsigned int worst = 0;
+static bool tracking = true;
+
+static unsigned int evaluate(const void *genome, const void *problem) {
+  const unsigned char *chromosomes = genome;
+  const unsigned int *size = problem;
+  unsigned int note = 0;
+  for (unsigned int index = 0; index < *size; index++) {
+    note += chromosomes[index] - 1U;
+  }
+  return note;
+}
+
+/**
+ * Lowers the first chromosome above 1, recording the worst rating it was given.
+ */
+static unsigned int lower(void *genome, unsigned int note, const void *problem, Random *random) {
+  unsigned char *chromosomes = genome;
+  const unsigned int *size = problem;
+  (void)random;
+  __atomic_fetch_add(&searched, 1, __ATOMIC_RELAXED);
+  if (tracking && note > worst) {
+    worst = note;
+  }
+  assert(note == evaluate(genome, problem));
+  for (unsigned int index = 0; index < *size; index++) {
+    if (chromosomes[index] > 1) {
+      chromosomes[index]--;
+      return note - 1;
+    }
+  }
+  return note;
+}
+
+static Population *run(const GeneticGenerator *generator, unsigned int threads, const unsigned int *size) {
+  Solver *solver = ga_solver_set_threads(ga_solver_create(9), threads);
+  ga_solver_set_local_search(solver, lower, 0.25f, GA_LOCAL_SEARCH_RANDOM);
+  Population *population = ga_population_create(solver, generator, 40);
+  for (unsigned int generation = 0; generation < 10; generation++) {
+    population = ga_population_next(solver, population, 0.5f, 0.05f, evaluate, size);
+  }
+  assert(ga_solver_get_local_search_time(solver) > 0);
+  ga_solver_destroy(solver);
+  return population;
+}
+
+int main(void) {
+  ga_init();
+  {
+    unsigned int size = 20;
+    GeneticGenerator *generator = genetic_generator_create(size);
+    for (unsigned int index = 0; index < size; index++) {
+      genetic_generator_set_cardinality(generator, index, 9);
+    }
+
+    /* the best quarter is improved: the others are rated no better than the worst one searched */
+    Solver *solver = ga_solver_create(4);
+    Population *population = ga_population_create(solver, generator, 40);
+    ga_solver_set_local_search(solver, lower, 0.25f, GA_LOCAL_SEARCH_BEST);
+    ga_population_next(solver, population, 0.5f, 0.05f, evaluate, &size);
+    assert(searched == 10);
+    for (unsigned int j = 10; j < population->size; j++) {
+      assert(population->ranks[population->picks[j]].note >= worst);
+    }
+    ga_population_destroy(population);
+    ga_solver_destroy(solver);
+
+    /* the improvements do not depend on the threads */
+    tracking = false;
+    searched = 0;
+    Population *serial = run(generator, 1, &size);
+    assert(searched == 100);
+    Population *parallel = run(generator, 4, &size);
+    assert(memcmp(serial->genomes, parallel->genomes, 40 * size) == 0);
+    ga_population_destroy(parallel);
+    ga_population_destroy(serial);
+    genetic_generator_destroy(generator);
+
+    /* the hill climber never worsens a sudoku and keeps its rows and candidates */
+    unsigned int givens[81];
+    for (int i = 0; i < 81; i++) {
+      givens[i] = i % 3 ? 0 : (unsigned int)((i / 9 * 3 + i / 27 + i % 9) % 9 + 1);
+    }
+    Sudoku *sudoku = sudoku_create(givens);
+    generator = sudoku_generator(sudoku);
+    solver = ga_solver_create(6);
+    population = ga_population_create(solver, generator, 30);
+    for (unsigned int i = 0; i < population->size; i++) {
+      void *genome = population->individuals[i].genome;
+      unsigned int note = sudoku_fitness(genome, sudoku);
+      unsigned int improved = sudoku_local_search(genome, note, sudoku, ga_solver_get_random(solver));
+      unsigned char grid[81];
+      assert(improved <= note);
+      assert(improved == sudoku_fitness(genome, sudoku));
+      sudoku_decode(sudoku, genome, grid);
+      for (int row = 0; row < 9; row++) {
+        unsigned int seen = 0;
+        for (int column = 0; column < 9; column++) {
+          seen |= 1u << grid[row * 9 + column];
+        }
+        assert(seen == 0x3FE);
+      }
+      for (int cell = 0; cell < 81; cell++) {
+        assert(givens[cell] || (sudoku->candidates[cell] & (1u << grid[cell])));
+      }
+    }
+    ga_population_destroy(population);
+    ga_solver_destroy(solver);
+    genetic_generator_destroy(generator);
+    sudoku_destroy(sudoku);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
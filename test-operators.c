@@ -0,0 +1,165 @@
+/**
+ * @file test-operators.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+
+#define SIZE 12
+
+static const unsigned int values[5] = {1, 2, 3, 4, 5};
+
+/**
+ * Checks that a genome respects the generator: two segments holding permutations of 1..5 at 2 and 7,
+ * chromosome 0 in {3, 6} and every other chromosome within its cardinality.
+ */
+static void check(const unsigned char *genome) {
+  for (unsigned int begin = 2; begin < SIZE; begin += 5) {
+    unsigned int seen = 0;
+    for (unsigned int index = begin; index < begin + 5; index++) {
+      seen |= 1u << genome[index];
+    }
+    assert(seen == 0x3E);
+  }
+  assert(genome[0] == 3 || genome[0] == 6);
+  assert(genome[1] >= 1 && genome[1] <= 4);
+}
+
+static unsigned int evaluate(const void *genome, const void *problem) {
+  const unsigned char *chromosomes = genome;
+  unsigned int note = 0;
+  (void)problem;
+  for (unsigned int index = 0; index < SIZE; index++) {
+    note += chromosomes[index] * (index % 3);
+  }
+  return note;
+}
+
+int main(void) {
+  ga_init();
+  {
+    const unsigned int domain[2] = {3, 6};
+    Random random;
+    ga_random_seed(&random, 17, 0);
+
+    /* the geometric skips follow the distribution of the number of failures */
+    unsigned long long total = 0;
+    for (unsigned int i = 0; i < 20000; i++) {
+      total += ga_random_geometric(&random, 0.1);
+    }
+    assert(total > 20000 * 8.5 && total < 20000 * 9.5);
+    assert(ga_random_geometric(&random, 1) == 0);
+    assert(ga_random_geometric(&random, 0) == UINT_MAX);
+
+    /* without segments, the cross-overs exchange single chromosomes */
+    GeneticGenerator *plain = genetic_generator_create(SIZE);
+    for (unsigned int index = 0; index < SIZE; index++) {
+      genetic_generator_set_cardinality(plain, index, 9);
+    }
+    unsigned char sister[SIZE];
+    unsigned char brother[SIZE];
+    memset(sister, 1, SIZE);
+    memset(brother, 2, SIZE);
+    ga_cross_over_uniform(plain, 1, sister, brother, 1.0f, &random, NULL);
+    for (unsigned int index = 0; index < SIZE; index++) {
+      assert(sister[index] == 2 && brother[index] == 1);
+    }
+    ga_cross_over_uniform(plain, 1, sister, brother, 0.0f, &random, NULL);
+    assert(sister[0] == 2);
+    for (unsigned int run = 0; run < 50; run++) {
+      unsigned int changes = 0;
+      memset(sister, 1, SIZE);
+      memset(brother, 2, SIZE);
+      ga_cross_over_one_point(plain, 1, sister, brother, 1.0f, &random, NULL);
+      assert(sister[0] == 1);
+      for (unsigned int index = 1; index < SIZE; index++) {
+        changes += sister[index] != sister[index - 1];
+        assert(sister[index] + brother[index] == 3);
+      }
+      assert(changes == 1);
+      memset(sister, 1, SIZE);
+      memset(brother, 2, SIZE);
+      ga_cross_over_two_point(plain, 1, sister, brother, 1.0f, &random, NULL);
+      changes = 0;
+      for (unsigned int index = 1; index < SIZE; index++) {
+        changes += sister[index] != sister[index - 1];
+      }
+      assert(changes <= 2);
+      /* creeping moves by one step within the cardinality */
+      memset(sister, 9, SIZE);
+      ga_mutation_creep(plain, 1, sister, 1.0f, &random, NULL);
+      for (unsigned int index = 0; index < SIZE; index++) {
+        assert(sister[index] == 8 || sister[index] == 9);
+      }
+    }
+    memset(sister, 1, SIZE);
+    memset(brother, 2, SIZE);
+    ga_cross_over_segment(plain, 1, sister, brother, 1.0f, &random, NULL);
+    assert(sister[0] == 1 && brother[SIZE - 1] == 2);
+    genetic_generator_destroy(plain);
+
+    /* with segments and domains, every operator keeps the genomes valid */
+    GeneticGenerator *generator = genetic_generator_create(SIZE);
+    genetic_generator_set_domain(generator, 0, domain, 2);
+    genetic_generator_set_cardinality(generator, 1, 4);
+    genetic_generator_set_segment(generator, 2, 5, values);
+    genetic_generator_set_segment(generator, 7, 5, values);
+    const CrossOverFunction crosses[4] = {ga_cross_over_uniform, ga_cross_over_one_point, ga_cross_over_two_point,
+                                          ga_cross_over_segment};
+    const MutationFunction mutations[3] = {ga_mutation_reset, ga_mutation_swap, ga_mutation_creep};
+    unsigned char mom[SIZE] = {3, 1, 1, 2, 3, 4, 5, 5, 4, 3, 2, 1};
+    unsigned char dad[SIZE] = {6, 4, 2, 1, 5, 3, 4, 1, 2, 3, 4, 5};
+    for (unsigned int run = 0; run < 200; run++) {
+      memcpy(sister, mom, SIZE);
+      memcpy(brother, dad, SIZE);
+      crosses[run % 4](generator, 1, sister, brother, 0.5f, &random, NULL);
+      for (unsigned int begin = 2; begin < SIZE; begin += 5) {
+        assert(memcmp(sister + begin, mom + begin, 5) == 0 || memcmp(sister + begin, dad + begin, 5) == 0);
+      }
+      for (unsigned int index = 0; index < SIZE; index++) {
+        assert(sister[index] + brother[index] == mom[index] + dad[index]);
+      }
+      mutations[run % 3](generator, 1, sister, 0.5f, &random, NULL);
+      mutations[run % 3](generator, 1, brother, 0.5f, &random, NULL);
+      check(sister);
+      check(brother);
+    }
+
+    /* a solver breeds with the operators it is given */
+    Solver *solver = ga_solver_create(4);
+    ga_solver_set_verbose(solver, false);
+    assert(ga_solver_set_cross_over(solver, ga_cross_over_two_point) == solver);
+    assert(ga_solver_set_mutation(solver, ga_mutation_swap) == solver);
+    Population *population = ga_population_create(solver, generator, 20);
+    for (unsigned int generation = 0; generation < 10; generation++) {
+      ga_population_next(solver, population, 0.7f, 0.2f, evaluate, NULL);
+      for (unsigned int i = 0; i < population->size; i++) {
+        check(population->individuals[i].genome);
+      }
+    }
+    assert(ga_solver_set_cross_over(solver, NULL) == solver);
+    assert(ga_solver_set_mutation(solver, ga_mutation_creep) == solver);
+    ga_population_next(solver, population, 0.7f, 0.2f, evaluate, NULL);
+    for (unsigned int i = 0; i < population->size; i++) {
+      check(population->individuals[i].genome);
+    }
+    ga_population_destroy(population);
+    ga_solver_destroy(solver);
+    genetic_generator_destroy(generator);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
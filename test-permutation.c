@@ -0,0 +1,132 @@
+/**
+ * @file test-permutation.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+#include "./sudoku.h"
+
+/**
+ * Checks that every row of a population holds a permutation of the values of its segments.
+ */
+static void check(const Population *population, const unsigned int *values, unsigned int length) {
+  for (unsigned int i = 0; i < population->size; i++) {
+    for (unsigned int begin = 0; begin < 2 * length; begin += length) {
+      unsigned int seen = 0;
+      for (unsigned int index = begin; index < begin + length; index++) {
+        seen |= 1u << ga_individual_get(&population->individuals[i], index);
+      }
+      for (unsigned int index = 0; index < length; index++) {
+        assert(seen & (1u << values[index]));
+      }
+    }
+    unsigned int value = ga_individual_get(&population->individuals[i], 2 * length);
+    assert(value == 2 || value == 4);
+  }
+}
+
+static unsigned int evaluate(const void *genome, const void *problem) {
+  const unsigned char *chromosomes = genome;
+  unsigned int note = 0;
+  (void)problem;
+  for (unsigned int index = 0; index < 5; index++) {
+    note += chromosomes[index] * index;
+  }
+  return note;
+}
+
+int main(void) {
+  ga_init();
+  {
+    const unsigned int values[5] = {2, 3, 5, 7, 11};
+    const unsigned int domain[2] = {2, 4};
+    unsigned int count;
+    GeneticGenerator *generator = genetic_generator_create(11);
+    assert(genetic_generator_get_domain(generator, 10, &count) == NULL && count == 0);
+    assert(genetic_generator_set_domain(generator, 10, values, 5) == generator);
+    assert(genetic_generator_set_domain(generator, 2, values, 1) == generator);
+    assert(genetic_generator_set_domain(generator, 10, domain, 2) == generator);
+    assert(genetic_generator_set_domain(generator, 2, NULL, 0) == generator);
+    assert(genetic_generator_get_domain(generator, 10, &count)[1] == 4 && count == 2);
+    assert(genetic_generator_get_cardinality(generator, 10) == 11);
+    genetic_generator_get_domain(generator, 2, &count);
+    assert(count == 0);
+    /* the last chromosome of the first segment never holds 2 */
+    assert(genetic_generator_set_domain(generator, 4, values + 1, 4) == generator);
+    assert(genetic_generator_set_segment(generator, 0, 5, values) == generator);
+    assert(genetic_generator_set_segment(generator, 5, 5, values) == generator);
+    assert(genetic_generator_set_segment(generator, 4, 2, values) == NULL);
+    assert(genetic_generator_set_segment(generator, 9, 2, values) == NULL);
+    assert(genetic_generator_get_segment(generator, 0) == 5);
+    assert(genetic_generator_get_segment(generator, 5) == 5);
+    assert(genetic_generator_get_segment(generator, 3) == 0);
+    assert(genetic_generator_get_cardinality(generator, 4) == 11);
+
+    GeneticGenerator *clone = genetic_generator_clone(generator);
+    assert(genetic_generator_get_segment(clone, 5) == 5);
+    assert(genetic_generator_get_domain(clone, 4, &count)[0] == 3 && count == 4);
+    genetic_generator_destroy(clone);
+
+    Solver *solver = ga_solver_create(3);
+    Population *population = ga_population_create(solver, generator, 40);
+    check(population, values, 5);
+    for (unsigned int generation = 0; generation < 30; generation++) {
+      ga_population_next(solver, population, 0.5f, 0.3f, evaluate, NULL);
+      check(population, values, 5);
+      for (unsigned int i = 0; i < population->size; i++) {
+        assert(ga_individual_get(&population->individuals[i], 4) != 2);
+      }
+    }
+    ga_population_destroy(population);
+    ga_solver_destroy(solver);
+    genetic_generator_destroy(generator);
+
+    /* a sudoku genome only holds the free cells, every row missing its given digits */
+    unsigned int givens[81] = {0};
+    for (int i = 0; i < 81; i++) {
+      givens[i] = i % 4 ? (unsigned int)((i / 9 * 3 + i / 27 + i % 9) % 9 + 1) : 0;
+    }
+    Sudoku *sudoku = sudoku_create(givens);
+    assert(sudoku->size == 21);
+    generator = sudoku_generator(sudoku);
+    assert(genetic_generator_get_size(generator) == 21);
+    solver = ga_solver_create(5);
+    population = ga_population_create(solver, generator, 20);
+    for (unsigned int generation = 0; generation < 5; generation++) {
+      ga_population_next(solver, population, 0.5f, 0.1f, sudoku_fitness, sudoku);
+    }
+    for (unsigned int i = 0; i < population->size; i++) {
+      unsigned char grid[81];
+      sudoku_decode(sudoku, population->individuals[i].genome, grid);
+      for (int row = 0; row < 9; row++) {
+        unsigned int seen = 0;
+        for (int column = 0; column < 9; column++) {
+          seen |= 1u << grid[row * 9 + column];
+        }
+        assert(seen == 0x3FE);
+      }
+      for (int cell = 0; cell < 81; cell++) {
+        assert(!givens[cell] || grid[cell] == givens[cell]);
+        assert(givens[cell] || (sudoku->candidates[cell] & (1u << grid[cell])));
+      }
+    }
+    ga_population_destroy(population);
+    ga_solver_destroy(solver);
+    genetic_generator_destroy(generator);
+    sudoku_destroy(sudoku);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
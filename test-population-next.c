@@ -0,0 +1,81 @@
+/**
+ * @file test-population-next.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdlib.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+
+static unsigned int allocations = 0;
+
+static void *counting_malloc(size_t size) {
+  allocations++;
+  return malloc(size);
+}
+
+static void *counting_realloc(void *ptr, size_t size) {
+  allocations++;
+  return realloc(ptr, size);
+}
+
+static unsigned int evaluate(const void *genome, const void *problem) {
+  const unsigned char *chromosomes = genome;
+  const unsigned int *size = problem;
+  unsigned int note = 0;
+  for (unsigned int index = 0; index < *size; index++) {
+    note += chromosomes[index] - 1U;
+  }
+  return note;
+}
+
+int main(void) {
+  ga_malloc = counting_malloc;
+  ga_realloc = counting_realloc;
+  ga_init();
+  {
+    unsigned int size = 20;
+    GeneticGenerator* generator = genetic_generator_create(size);
+    for (unsigned int index = 0; index < size; index++) {
+      genetic_generator_set_cardinality(generator, index, 9);
+    }
+    Solver* solver = ga_solver_create(1);
+    Population* population = ga_population_create(solver, generator, 50);
+    assert(population != NULL);
+
+    /* warm up: the best individual storage is allocated once */
+    population = ga_population_next(solver, population, 0.5f, 0.05f, evaluate, &size);
+    assert(get_best_individual(solver) != NULL);
+    assert(ga_solver_get_generation(solver) == 2);
+
+    allocations = 0;
+    for (unsigned int generation = 0; generation < 20; generation++) {
+      Population* next = ga_population_next(solver, population, 0.5f, 0.05f, evaluate, &size);
+      assert(next == population);
+      for (unsigned int i = 0; i < population->size; i++) {
+        assert((unsigned char *)population->individuals[i].genome == population->genomes + i * size);
+        for (unsigned int index = 0; index < size; index++) {
+          unsigned int chromosome = ga_individual_get(&population->individuals[i], index);
+          assert(chromosome >= 1 && chromosome <= 9);
+        }
+      }
+    }
+    assert(allocations == 0);
+    assert(evaluate(get_best_individual(solver)->genome, &size) == get_best_score(solver));
+
+    ga_population_destroy(population);
+    ga_solver_destroy(solver);
+    genetic_generator_destroy(generator);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file test-population.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+
+int main(void) {
+  ga_init();
+  {
+    GeneticGenerator* generator = genetic_generator_create(10);
+    for (unsigned int index = 0; index < genetic_generator_get_size(generator); index++) {
+      genetic_generator_set_cardinality(generator, index, index + 1);
+    }
+
+    Solver* solver = ga_solver_create(1);
+    assert(ga_population_create(solver, generator, 0) == NULL);
+    assert(ga_population_create(solver, generator, 3) == NULL);
+
+    assert(genetic_generator_get_width(generator) == 1);
+    Population* population = ga_population_create(solver, generator, 6);
+    assert(population != NULL);
+    assert(((uintptr_t)population->genomes % 64) == 0);
+    for (unsigned int i = 0; i < population->size; i++) {
+      assert(population->individuals[i].index == i);
+      assert((unsigned char*)population->individuals[i].genome == population->genomes + i * 10);
+      for (unsigned int index = 0; index < genetic_generator_get_size(generator); index++) {
+        assert(ga_individual_get(&population->individuals[i], index) >= 1);
+        assert(ga_individual_get(&population->individuals[i], index) <= index + 1);
+      }
+    }
+
+    Population* clone = ga_population_clone(population);
+    assert(clone != NULL);
+    assert(clone->size == population->size);
+    assert(memcmp(clone->genomes, population->genomes, 6 * 10) == 0);
+    assert((unsigned char*)clone->individuals[5].genome == clone->genomes + 5 * 10);
+
+    Individual* individual = ga_individual_clone(&population->individuals[2]);
+    assert(memcmp(individual->genome, population->individuals[2].genome, 10) == 0);
+    assert(ga_individual_get(ga_individual_set(individual, 3, 2), 3) == 2);
+    ga_individual_destroy(individual);
+
+    /* the chromosomes are stored on the narrowest width holding the cardinalities */
+    genetic_generator_set_cardinality(generator, 9, 300);
+    assert(genetic_generator_get_width(generator) == 2);
+    Population* wide = ga_population_create(solver, generator, 2);
+    assert(wide->individuals[1].width == 2);
+    assert((unsigned char*)wide->individuals[1].genome == wide->genomes + 20);
+    assert(ga_individual_get(&wide->individuals[1], 9) >= 1 && ga_individual_get(&wide->individuals[1], 9) <= 300);
+    ga_population_destroy(wide);
+    genetic_generator_set_cardinality(generator, 9, 70000);
+    assert(genetic_generator_get_width(generator) == 4);
+
+    unsigned char genome[4] = {0};
+    ga_genome_set(genome, 2, 1, 513);
+    assert(ga_genome_get(genome, 2, 1) == 513);
+    assert(ga_genome_get(genome, 1, 0) == 0);
+
+    ga_population_destroy(clone);
+    ga_population_destroy(population);
+    ga_solver_destroy(solver);
+    genetic_generator_destroy(generator);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file test-progress.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+
+typedef struct {
+  const Solver *solver;
+  unsigned int calls;
+  unsigned int generations[8];
+  bool statistics;
+} Reports;
+
+static unsigned int evaluate(const void *genome, const void *problem) {
+  const unsigned char *chromosomes = genome;
+  const unsigned int *size = problem;
+  unsigned int note = 0;
+  for (unsigned int index = 0; index < *size; index++) {
+    note += chromosomes[index];
+  }
+  return note;
+}
+
+static void record(const Progress *progress, void *data) {
+  Reports *reports = data;
+  assert(progress->best_score == get_best_score(reports->solver));
+  assert(progress->evaluations == ga_solver_get_evaluations(reports->solver));
+  assert(progress->generation + 1 == ga_solver_get_generation(reports->solver));
+  reports->statistics = progress->statistics != NULL;
+  reports->generations[reports->calls++] = progress->generation;
+}
+
+int main(void) {
+  ga_init();
+  {
+    unsigned int size = 10;
+    GeneticGenerator *generator = genetic_generator_create(size);
+    for (unsigned int index = 0; index < size; index++) {
+      genetic_generator_set_cardinality(generator, index, 9);
+    }
+    Solver *solver = ga_solver_create(2);
+    Population *population = ga_population_create(solver, generator, 20);
+    Reports reports = {solver, 0, {0}, false};
+
+    /* solvers are silent unless they are given a progress function */
+    assert(!solver->progress);
+    assert(ga_solver_set_progress(solver, record, 3, &reports) == solver);
+    for (unsigned int generation = 0; generation < 10; generation++) {
+      population = ga_population_next(solver, population, 0.5f, 0.1f, evaluate, &size);
+    }
+    assert(reports.calls == 3);
+    assert(reports.generations[0] == 3 && reports.generations[1] == 6 && reports.generations[2] == 9);
+    assert(!reports.statistics);
+
+#if GA_INSTRUMENTATION
+    ga_solver_set_instrumentation(solver, 1);
+    ga_solver_set_progress(solver, record, 0, &reports);
+    population = ga_population_next(solver, population, 0.5f, 0.1f, evaluate, &size);
+    assert(reports.calls == 4 && reports.statistics);
+#endif
+
+    /* the verbose reports go to the standard output, or any file */
+    assert(ga_solver_set_verbose(solver, true)->progress == ga_progress_print);
+    assert(!ga_solver_set_verbose(solver, false)->progress);
+    FILE *stream = tmpfile();
+    char line[64];
+    Progress progress = {7, 12, 100, NULL};
+    ga_progress_print(&progress, stream);
+    rewind(stream);
+    assert(fgets(line, sizeof(line), stream) && !strcmp(line, "Current generation : 7\n"));
+    assert(fgets(line, sizeof(line), stream) && !strcmp(line, "Best score : 12\n"));
+    fclose(stream);
+
+    ga_population_destroy(population);
+    ga_solver_destroy(solver);
+    genetic_generator_destroy(generator);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file test-random.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdlib.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+
+int main(void) {
+  ga_seed(1234);
+  ga_init();
+  {
+    Random first, second, other;
+    ga_random_seed(&first, 42, 0);
+    ga_random_seed(&second, 42, 0);
+    ga_random_seed(&other, 42, 1);
+    unsigned int differences = 0;
+    for (unsigned int i = 0; i < 100; i++) {
+      unsigned long long value = ga_random_next(&first);
+      assert(value == ga_random_next(&second));
+      differences += value != ga_random_next(&other);
+    }
+    assert(differences == 100);
+
+    unsigned int hits[7] = {0};
+    for (unsigned int i = 0; i < 7000; i++) {
+      unsigned int value = ga_random_number(&first, 7);
+      assert(value < 7);
+      hits[value]++;
+    }
+    for (unsigned int i = 0; i < 7; i++) {
+      assert(hits[i] > 800 && hits[i] < 1200);
+    }
+
+    unsigned int words[5];
+    float floats[5];
+    ga_random_fill(&first, words, 5);
+    ga_random_fill_float(&first, floats, 5);
+    for (unsigned int i = 0; i < 5; i++) {
+      assert(floats[i] >= 0 && floats[i] < 1);
+      double unit = ga_random_unit(&first);
+      assert(unit >= 0 && unit < 1);
+    }
+
+    /* the default generator is reproducible */
+    int numbers[20];
+    ga_seed(99);
+    for (unsigned int i = 0; i < 20; i++) {
+      numbers[i] = random_number(1, 9);
+      assert(numbers[i] >= 1 && numbers[i] <= 9);
+    }
+    ga_seed(99);
+    for (unsigned int i = 0; i < 20; i++) {
+      assert(random_number(1, 9) == numbers[i]);
+    }
+    assert(random_number(5, 5) == 5);
+    assert(random_float(2, 2) == 2);
+    float value = random_float(1, 3);
+    assert(value >= 1 && value <= 3);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
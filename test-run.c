@@ -0,0 +1,115 @@
+/**
+ * @file test-run.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+
+static unsigned int evaluate(const void *genome, const void *problem) {
+  const unsigned char *chromosomes = genome;
+  const unsigned int *size = problem;
+  unsigned int note = 0;
+  for (unsigned int index = 0; index < *size; index++) {
+    note += chromosomes[index];
+  }
+  return note;
+}
+
+static unsigned int constant(const void *genome, const void *problem) {
+  (void)genome;
+  (void)problem;
+  return 1;
+}
+
+int main(void) {
+  ga_init();
+  {
+    unsigned int size = 10;
+    GeneticGenerator *generator = genetic_generator_create(size);
+    for (unsigned int index = 0; index < size; index++) {
+      genetic_generator_set_cardinality(generator, index, 9);
+    }
+    Solver *solver = ga_solver_create(3);
+    ga_solver_set_verbose(solver, false);
+    Population *population = ga_population_create(solver, generator, 20);
+
+    /* a run checks its criteria after each generation */
+    StopCriteria target = {100, UINT_MAX - 1, 0, 0, 0};
+    assert(ga_run(solver, population, &target, 0.5f, 0.1f, evaluate, &size) == GA_STOP_TARGET);
+    assert(ga_solver_get_generation(solver) == 2);
+    assert(ga_solver_get_evaluations(solver) == 20);
+
+    StopCriteria reached = {1000, 30, 0, 0, 0};
+    assert(ga_run(solver, population, &reached, 0.5f, 0.1f, evaluate, &size) == GA_STOP_TARGET);
+    assert(get_best_score(solver) <= 30);
+
+    /* the other criteria are relative to the start of the run */
+    ga_solver_reset(solver, 3, 0);
+    StopCriteria generations = {5, 0, 0, 0, 0};
+    assert(ga_run(solver, population, &generations, 0.5f, 0.1f, constant, NULL) == GA_STOP_GENERATIONS);
+    assert(ga_solver_get_generation(solver) == 6);
+    assert(ga_run(solver, population, &generations, 0.5f, 0.1f, constant, NULL) == GA_STOP_GENERATIONS);
+    assert(ga_solver_get_generation(solver) == 11);
+
+    ga_solver_reset(solver, 3, 0);
+    StopCriteria stagnation = {100, 0, 3, 0, 0};
+    assert(ga_run(solver, population, &stagnation, 0.5f, 0.1f, constant, NULL) == GA_STOP_STAGNATION);
+    assert(ga_solver_get_generation(solver) == 5);
+
+    ga_solver_reset(solver, 3, 0);
+    StopCriteria evaluations = {100, 0, 0, 0, 50};
+    assert(ga_run(solver, population, &evaluations, 0.5f, 0.1f, constant, NULL) == GA_STOP_EVALUATIONS);
+    assert(ga_solver_get_evaluations(solver) == 60);
+
+    ga_solver_reset(solver, 3, 0);
+    StopCriteria time = {0, 0, 0, 0.01, 0};
+    assert(ga_run(solver, population, &time, 0.5f, 0.1f, constant, NULL) == GA_STOP_TIME);
+
+    assert(strcmp(ga_stop_reason_to_string(GA_STOP_STAGNATION), "stagnation") == 0);
+
+    ga_population_destroy(population);
+    ga_solver_destroy(solver);
+
+    /* an archipelago stops as a whole */
+    Islands *islands = ga_islands_create(generator, 3, 20, 5);
+    assert(ga_islands_set_migration(islands, 2, 1, GA_TOPOLOGY_RING) == islands);
+    assert(ga_islands_run(islands, &target, 0.5f, 0.1f, evaluate, &size) == GA_STOP_TARGET);
+    assert(ga_islands_run(islands, &evaluations, 0.5f, 0.1f, constant, NULL) == GA_STOP_EVALUATIONS);
+    assert(ga_islands_run(islands, &stagnation, 0.5f, 0.1f, constant, NULL) == GA_STOP_STAGNATION);
+    for (unsigned int i = 0; i < 3; i++) {
+      assert(ga_solver_get_generation(ga_islands_get_solver(islands, i)) < 100);
+    }
+    ga_islands_destroy(islands);
+
+    /* elites are not evaluated again and do not use the budget of an archipelago */
+    islands = ga_islands_create(generator, 3, 20, 5);
+    for (unsigned int i = 0; i < 3; i++) {
+      ga_solver_set_elitism(ga_islands_get_solver(islands, i), 10);
+    }
+    StopCriteria budget = {100, 0, 0, 0, 100};
+    assert(ga_islands_run(islands, &budget, 0.5f, 0.1f, constant, NULL) == GA_STOP_EVALUATIONS);
+    unsigned long long evaluated = 0;
+    for (unsigned int i = 0; i < 3; i++) {
+      evaluated += ga_solver_get_evaluations(ga_islands_get_solver(islands, i));
+    }
+    assert(evaluated >= 100 && evaluated < 100 + 3 * 20);
+    ga_islands_destroy(islands);
+
+    genetic_generator_destroy(generator);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
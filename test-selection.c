@@ -0,0 +1,107 @@
+/**
+ * @file test-selection.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+
+static unsigned int evaluate(const void *genome, const void *problem) {
+  const unsigned char *chromosomes = genome;
+  const unsigned int *size = problem;
+  unsigned int note = 0;
+  for (unsigned int index = 0; index < *size; index++) {
+    note += chromosomes[index] * (index + 1);
+  }
+  return note;
+}
+
+static int compare(const void *first, const void *second) {
+  unsigned int a = *(const unsigned int *)first;
+  unsigned int b = *(const unsigned int *)second;
+  return (a > b) - (a < b);
+}
+
+/* breeds copies of the parents and returns the sorted ratings of the parents and of the children */
+static void breed(Solver *solver, const GeneticGenerator *generator, unsigned int *parents, unsigned int *children) {
+  unsigned int size = 12;
+  Population *population = ga_population_create(solver, generator, 40);
+  for (unsigned int i = 0; i < 40; i++) {
+    parents[i] = evaluate(population->individuals[i].genome, &size);
+  }
+  ga_population_next(solver, population, 0.0f, 0.0f, evaluate, &size);
+  for (unsigned int i = 0; i < 40; i++) {
+    children[i] = evaluate(population->individuals[i].genome, &size);
+  }
+  qsort(parents, 40, sizeof(unsigned int), compare);
+  ga_population_destroy(population);
+}
+
+static unsigned long long sum(const unsigned int *notes) {
+  unsigned long long total = 0;
+  for (unsigned int i = 0; i < 40; i++) {
+    total += notes[i];
+  }
+  return total;
+}
+
+int main(void) {
+  ga_init();
+  {
+    GeneticGenerator *generator = genetic_generator_create(12);
+    for (unsigned int index = 0; index < 12; index++) {
+      genetic_generator_set_cardinality(generator, index, 9);
+    }
+    Solver *solver = ga_solver_create(21);
+    ga_solver_set_verbose(solver, false);
+    unsigned int parents[40];
+    unsigned int children[40];
+
+    /* a truncation only breeds the best fraction */
+    assert(ga_solver_set_selection(solver, GA_SELECTION_TRUNCATION, 0.1f) == solver);
+    breed(solver, generator, parents, children);
+    for (unsigned int i = 0; i < 40; i++) {
+      assert(children[i] <= parents[3]);
+    }
+
+    /* a tournament as large as the population always picks the best as the first parent */
+    assert(ga_solver_set_selection(solver, GA_SELECTION_TOURNAMENT, 1000.0f) == solver);
+    breed(solver, generator, parents, children);
+    for (unsigned int i = 0; i < 40; i += 2) {
+      assert(children[i] == parents[0]);
+    }
+
+    /* a tournament of one and a ranking without pressure are uniform, pressure favours the best */
+    assert(ga_solver_set_selection(solver, GA_SELECTION_TOURNAMENT, 0.0f) == solver);
+    assert(solver->selection_parameter == 1.0f);
+    assert(ga_solver_set_selection(solver, GA_SELECTION_RANK, 2.0f) == solver);
+    unsigned long long before = 0;
+    unsigned long long after = 0;
+    for (unsigned int run = 0; run < 20; run++) {
+      breed(solver, generator, parents, children);
+      before += sum(parents);
+      after += sum(children);
+    }
+    assert(after < before);
+
+    assert(ga_solver_set_selection(solver, GA_SELECTION_ROULETTE, 5.0f) == solver);
+    assert(solver->selection_parameter == 0.0f);
+    breed(solver, generator, parents, children);
+
+    ga_solver_destroy(solver);
+    genetic_generator_destroy(generator);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
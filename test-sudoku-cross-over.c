@@ -0,0 +1,125 @@
+/**
+ * @file test-sudoku-cross-over.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+#include "./sudoku.h"
+
+/**
+ * Tells which parents a row of a child may come from: bit 0 for the first parent, bit 1 for the second one.
+ */
+static unsigned int origin(const Sudoku *sudoku, const unsigned char *child, const unsigned char *mom,
+                           const unsigned char *dad, int row) {
+  unsigned int parents = 3;
+  for (int i = row * 9; i < row * 9 + 9; i++) {
+    if (sudoku->loci[i] != SUDOKU_GIVEN) {
+      unsigned int locus = sudoku->loci[i];
+      parents &= (child[locus] == mom[locus]) | (child[locus] == dad[locus]) << 1;
+    }
+  }
+  return parents;
+}
+
+int main(void) {
+  ga_init();
+  {
+    unsigned char solved[81];
+    unsigned int givens[81];
+    unsigned int conflicts[9];
+    for (int i = 0; i < 81; i++) {
+      solved[i] = (unsigned char)((i / 9 * 3 + i / 27 + i % 9) % 9 + 1);
+      givens[i] = i % 4 == 0 ? solved[i] : 0;
+    }
+    sudoku_row_conflicts(solved, conflicts);
+    for (int row = 0; row < 9; row++) {
+      assert(conflicts[row] == 0);
+    }
+    /* the same digit twice in a column and a block */
+    solved[9] = solved[0];
+    sudoku_row_conflicts(solved, conflicts);
+    assert(conflicts[0] == 2 && conflicts[1] == 2 && conflicts[2] == 0);
+
+    Sudoku *sudoku = sudoku_create(givens);
+    GeneticGenerator *generator = sudoku_generator(sudoku);
+    Solver *solver = ga_solver_create(8);
+    ga_solver_set_verbose(solver, false);
+    Population *population = ga_population_create(solver, generator, 8);
+    const unsigned char *mom = population->individuals[0].genome;
+    const unsigned char *dad = population->individuals[1].genome;
+    unsigned char sister[81];
+    unsigned char brother[81];
+    unsigned char grid[81];
+    unsigned int moms[9];
+    unsigned int dads[9];
+    Random *random = ga_solver_get_random(solver);
+    sudoku_decode(sudoku, mom, grid);
+    sudoku_row_conflicts(grid, moms);
+    sudoku_decode(sudoku, dad, grid);
+    sudoku_row_conflicts(grid, dads);
+
+    /* whole rows and bands are exchanged */
+    const CrossOverFunction crosses[3] = {sudoku_cross_over_rows, sudoku_cross_over_bands, sudoku_cross_over_guided};
+    for (int run = 0; run < 30; run++) {
+      memcpy(sister, mom, sudoku->size);
+      memcpy(brother, dad, sudoku->size);
+      crosses[run % 3](generator, 1, sister, brother, 0.5f, random, sudoku);
+      for (int row = 0; row < 9; row++) {
+        assert(origin(sudoku, sister, mom, dad, row));
+        assert(origin(sudoku, brother, mom, dad, row));
+        if (run % 3 == 1 && row % 3) {
+          assert(origin(sudoku, sister, mom, dad, row) == origin(sudoku, sister, mom, dad, row - 1));
+        }
+      }
+    }
+    memcpy(sister, mom, sudoku->size);
+    memcpy(brother, dad, sudoku->size);
+    sudoku_cross_over_rows(generator, 1, sister, brother, 1.0f, random, sudoku);
+    assert(memcmp(sister, dad, sudoku->size) == 0 && memcmp(brother, mom, sudoku->size) == 0);
+
+    /* the guided cross-over gives the sister the rows with the fewer conflicts */
+    memcpy(sister, mom, sudoku->size);
+    memcpy(brother, dad, sudoku->size);
+    sudoku_cross_over_guided(generator, 1, sister, brother, 1.0f, random, sudoku);
+    for (int row = 0; row < 9; row++) {
+      if (origin(sudoku, mom, dad, dad, row) != 3) {
+        assert(origin(sudoku, sister, mom, dad, row) == (moms[row] <= dads[row] ? 1u : 2u));
+      }
+    }
+
+    /* the solver keeps the rows of the encoding */
+    ga_solver_set_cross_over(solver, sudoku_cross_over_guided);
+    for (int generation = 0; generation < 5; generation++) {
+      ga_population_next(solver, population, 0.5f, 0.05f, sudoku_fitness, sudoku);
+    }
+    for (unsigned int i = 0; i < population->size; i++) {
+      sudoku_decode(sudoku, population->individuals[i].genome, grid);
+      for (int row = 0; row < 9; row++) {
+        unsigned int seen = 0;
+        for (int i = row * 9; i < row * 9 + 9; i++) {
+          seen |= 1u << grid[i];
+        }
+        assert(seen == 0x3FE);
+      }
+    }
+
+    ga_population_destroy(population);
+    ga_solver_destroy(solver);
+    genetic_generator_destroy(generator);
+    sudoku_destroy(sudoku);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file test-sudoku-fitness.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./sudoku.h"
+
+/**
+ * The original rating, counting the occurrences of every digit in copies of every unit.
+ */
+static unsigned int reference(const unsigned char *genome, const unsigned int *sudoku) {
+  unsigned int solution[81];
+  int note = 0;
+  for (int i = 0; i < 81; i++) {
+    solution[i] = genome[i];
+  }
+  for (int i = 0; i < 9; i++) {
+    unsigned int *units[3] = {get_row(solution, i), get_column(solution, i), get_block(solution, i)};
+    for (int t = 1; t < 10; t++) {
+      for (int unit = 0; unit < 3; unit++) {
+        if (count_occurrences(units[unit], 9, t) > 1) {
+          note += count_occurrences(units[unit], 9, t) - 1;
+        }
+      }
+    }
+    for (int unit = 0; unit < 3; unit++) {
+      free(units[unit]);
+    }
+  }
+  for (int i = 0; i < 81; i++) {
+    if (solution[i] != sudoku[i] && sudoku[i] != 0) {
+      note += 2;
+    }
+  }
+  return note;
+}
+
+int main(void) {
+  ga_init();
+  ga_seed(2019);
+  {
+    unsigned char solved[81];
+    unsigned int givens[81] = {0};
+    for (int i = 0; i < 81; i++) {
+      solved[i] = (unsigned char)((i / 9 * 3 + i / 27 + i % 9) % 9 + 1);
+    }
+    assert(fitness(solved, givens) == 0);
+    assert(reference(solved, givens) == 0);
+
+    unsigned char solution[81];
+    for (int board = 0; board < 10000; board++) {
+      for (int i = 0; i < 81; i++) {
+        /* out of range values are ignored by both ratings */
+        solution[i] = (unsigned char)random_number(board % 2, board % 3 ? 9 : 255);
+        givens[i] = random_number(0, 3) ? 0 : (unsigned int)random_number(1, 9);
+      }
+      assert(fitness(solution, givens) == reference(solution, givens));
+    }
+
+    /* batch ratings match single ones, whatever the size of the batch */
+    unsigned char boards[50][81];
+    const void *batch[50];
+    unsigned int notes[50];
+    for (int count = 0; count <= 50; count += 7) {
+      for (int board = 0; board < count; board++) {
+        for (int i = 0; i < 81; i++) {
+          boards[board][i] = (unsigned char)random_number(board % 2, board % 3 ? 9 : 255);
+          givens[i] = random_number(0, 3) ? 0 : (unsigned int)random_number(1, 9);
+        }
+        batch[board] = boards[board];
+      }
+      fitness_batch(batch, (unsigned int)count, notes, givens);
+      for (int board = 0; board < count; board++) {
+        assert(notes[board] == fitness(boards[board], givens));
+      }
+    }
+
+    /* incremental ratings match full ones */
+    unsigned char parent[81];
+    unsigned int changes[81];
+    for (int board = 0; board < 10000; board++) {
+      unsigned int count = 0;
+      for (int i = 0; i < 81; i++) {
+        parent[i] = solution[i] = (unsigned char)random_number(1, 9);
+        givens[i] = random_number(0, 3) ? 0 : (unsigned int)random_number(1, 9);
+      }
+      for (int i = 0; i < 81; i++) {
+        if (random_number(0, 80) < board % 16) {
+          solution[i] = (unsigned char)random_number(1, 9);
+          if (solution[i] != parent[i]) {
+            changes[count++] = (unsigned int)i;
+          }
+        }
+      }
+      assert(fitness_delta(parent, fitness(parent, givens), solution, changes, count, givens) ==
+             fitness(solution, givens));
+    }
+
+    /* the genome of an encoded sudoku is rated on its decoded grid */
+    Sudoku *sudoku = sudoku_create(givens);
+    unsigned char grids[40][81];
+    unsigned char genomes[40][81];
+    for (int board = 0; board < 40; board++) {
+      for (unsigned int i = 0; i < sudoku->size; i++) {
+        genomes[board][i] = (unsigned char)random_number(1, 9);
+      }
+      sudoku_decode(sudoku, genomes[board], grids[board]);
+      assert(sudoku_fitness(genomes[board], sudoku) == fitness(grids[board], givens));
+      batch[board % 50] = genomes[board];
+    }
+    sudoku_fitness_batch(batch, 40, notes, sudoku);
+    for (int board = 0; board < 40; board++) {
+      assert(notes[board] == sudoku_fitness(genomes[board], sudoku));
+    }
+    for (int board = 1; board < 40; board++) {
+      unsigned int count = 0;
+      memcpy(genomes[board], genomes[0], sudoku->size);
+      for (unsigned int i = 0; i < sudoku->size && count < (unsigned int)board % 5; i++) {
+        if (random_number(0, 3) == 0) {
+          genomes[board][i] = (unsigned char)(genomes[0][i] % 9 + 1);
+          changes[count++] = i;
+        }
+      }
+      assert(sudoku_fitness_delta(genomes[0], sudoku_fitness(genomes[0], sudoku), genomes[board], changes, count,
+                                  sudoku) == sudoku_fitness(genomes[board], sudoku));
+    }
+    sudoku_destroy(sudoku);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}
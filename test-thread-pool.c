@@ -0,0 +1,83 @@
+/**
+ * @file test-thread-pool.c
+ *
+ * @author     Christophe Demko <christophe.demko@univ-lr.fr>
+ * @date       2019
+ * @copyright  BSD 3-Clause License
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <assert.h>
+
+#include "./ga.h"
+#include "./ga.inc"
+
+static unsigned int evaluate(const void *genome, const void *problem) {
+  const unsigned char *chromosomes = genome;
+  const unsigned int *size = problem;
+  unsigned int note = 0;
+  for (unsigned int index = 0; index < *size; index++) {
+    note += (chromosomes[index] * (index + 1)) % 7;
+  }
+  return note;
+}
+
+static Population *run(const GeneticGenerator *generator, ThreadPool *pool, const unsigned int *size) {
+  Solver *solver = ga_solver_set_thread_pool(ga_solver_create(42), pool);
+  Population *population = ga_population_create(solver, generator, 64);
+  for (unsigned int generation = 0; generation < 10; generation++) {
+    population = ga_population_next(solver, population, 0.5f, 0.1f, evaluate, size);
+  }
+  ga_solver_destroy(solver);
+  return population;
+}
+
+int main(void) {
+  ga_init();
+  {
+    unsigned int size = 30;
+    GeneticGenerator *generator = genetic_generator_create(size);
+    for (unsigned int index = 0; index < size; index++) {
+      genetic_generator_set_cardinality(generator, index, 9);
+    }
+
+    ThreadPool *single = ga_thread_pool_create(1);
+    assert(ga_thread_pool_get_size(single) == 1);
+    ga_thread_pool_destroy(single);
+
+    ThreadPool *pool = ga_thread_pool_create(4);
+    assert(ga_thread_pool_get_size(pool) == 4);
+
+    Population *serial = run(generator, NULL, &size);
+    Population *parallel = run(generator, pool, &size);
+    assert(memcmp(serial->genomes, parallel->genomes, 64 * size) == 0);
+
+    /* a solver owning its threads gives the same run */
+    Solver *solver = ga_solver_set_threads(ga_solver_create(42), 3);
+    assert(solver != NULL);
+    Population *owned = ga_population_create(solver, generator, 64);
+    for (unsigned int generation = 0; generation < 10; generation++) {
+      owned = ga_population_next(solver, owned, 0.5f, 0.1f, evaluate, &size);
+    }
+    assert(memcmp(serial->genomes, owned->genomes, 64 * size) == 0);
+    ga_population_destroy(owned);
+    ga_solver_destroy(solver);
+
+    ga_population_destroy(parallel);
+    ga_population_destroy(serial);
+    ga_thread_pool_destroy(pool);
+
+    pool = ga_thread_pool_create(0);
+    assert(ga_thread_pool_get_size(pool) >= 1);
+    ga_thread_pool_destroy(pool);
+
+    genetic_generator_destroy(generator);
+  }
+  ga_finish();
+  return EXIT_SUCCESS;
+}